@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/brick_game/snake/SnakeModel.h"
+#include "../src/brick_game/tetris/TetrisModel.h"
+#include "../src/controller/Controller.h"
+
+namespace s21 {
+
+/**
+ * @brief Reaches the private update() of the models, which takes the
+ * dispatch to use.
+ */
+struct DispatchAccess {
+  template <class Model, bool kRuntimeDispatch>
+  static void update(Model& model, UserAction action) {
+    model.template update<kRuntimeDispatch>(action);
+  }
+};
+
+}  // namespace s21
+
+using namespace s21;
+
+namespace {
+
+/// Actions fed to the models: the snake runs around a small square, the
+/// Tetris figure moves and rotates and sinks to the floor.
+const UserAction kActions[] = {UserAction::LEFT_BTN,  UserAction::LEFT_BTN,
+                               UserAction::UP_BTN,    UserAction::UP_BTN,
+                               UserAction::RIGHT_BTN, UserAction::RIGHT_BTN,
+                               UserAction::DOWN_BTN,  UserAction::DOWN_BTN};
+
+/**
+ * @brief Plays the real handlers of a model through updateData() with one
+ * of the dispatches, on a clock that never moves, restarting the game
+ * whenever it ends. Both dispatches see the same sequence of states, so
+ * they share the cost of the handlers and of the restarts.
+ *
+ * The runtime dispatch reads a member pointer from the matrix, as
+ * updateData() did before the compile-time dispatcher.
+ */
+template <class Model, bool kRuntimeDispatch>
+void BM_Update(benchmark::State& state) {
+  const auto update = &DispatchAccess::update<Model, kRuntimeDispatch>;
+  VirtualClock clock;
+  Model model;
+  model.setScoreSaving(false);
+  model.setClock(&clock);
+  model.setSeed(42);
+  model.setDefault();
+  update(model, UserAction::ENTER_BTN);
+  size_t i = 0;
+  for (auto _ : state) {
+    const GameState game_state = model.getModelData().game_state;
+    if (game_state == GameState::GAMEOVER || game_state == GameState::EXIT) {
+      model.setDefault();
+      update(model, UserAction::ENTER_BTN);
+    } else {
+      update(model, kActions[i++ % 8]);
+    }
+  }
+  benchmark::DoNotOptimize(model.getVersion());
+}
+BENCHMARK(BM_Update<TetrisModel, true>)->Name("BM_TetrisDispatchRuntime");
+BENCHMARK(BM_Update<TetrisModel, false>)->Name("BM_TetrisDispatchStatic");
+BENCHMARK(BM_Update<SnakeModel, true>)->Name("BM_SnakeDispatchRuntime");
+BENCHMARK(BM_Update<SnakeModel, false>)->Name("BM_SnakeDispatchStatic");
+
+/// updateData() of a moving Tetris game called on the model directly.
+void BM_TetrisModelUpdate(benchmark::State& state) {
+  VirtualClock clock;
+  TetrisModel model;
+  model.setScoreSaving(false);
+  model.setClock(&clock);
+  model.setDefault();
+  model.updateData(UserAction::SPACE_BTN);
+  model.updateData(UserAction::NO_ACT);
+  for (auto _ : state) {
+    model.updateData(UserAction::NO_ACT);
+  }
+  benchmark::DoNotOptimize(model.getVersion());
+}
+BENCHMARK(BM_TetrisModelUpdate);
+
+/// The same call made through the Controller, as the views make it.
+void BM_TetrisControllerUpdate(benchmark::State& state) {
+  VirtualClock clock;
+  TetrisModel model;
+  model.setScoreSaving(false);
+  model.setClock(&clock);
+  Controller<TetrisModel, UserAction::NO_ACT> controller(&model);
+  controller.setModelToDefault();
+  controller.updateModelData(UserAction::SPACE_BTN);
+  controller.updateModelData();
+  for (auto _ : state) {
+    controller.updateModelData();
+  }
+  benchmark::DoNotOptimize(controller.getModelVersion());
+}
+BENCHMARK(BM_TetrisControllerUpdate);
+
+}  // namespace
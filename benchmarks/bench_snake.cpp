@@ -0,0 +1,148 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/brick_game/snake/SnakeModel.h"
+
+using namespace s21;
+
+namespace {
+
+/// Side of the square field, large enough for a 10k long snake.
+constexpr int kFieldSize = 128;
+
+UserAction actionFor(Direction direction) {
+  switch (direction) {
+    case Direction::UP:
+      return UserAction::UP_BTN;
+    case Direction::DOWN:
+      return UserAction::DOWN_BTN;
+    case Direction::LEFT:
+      return UserAction::LEFT_BTN;
+    default:
+      return UserAction::RIGHT_BTN;
+  }
+}
+
+Cords neighbour(const Cords& cell, Direction direction) {
+  switch (direction) {
+    case Direction::UP:
+      return Cords(cell.x_, cell.y_ - 1);
+    case Direction::DOWN:
+      return Cords(cell.x_, cell.y_ + 1);
+    case Direction::LEFT:
+      return Cords(cell.x_ - 1, cell.y_);
+    default:
+      return Cords(cell.x_ + 1, cell.y_);
+  }
+}
+
+/**
+ * @brief Gets the next step on a Hamiltonian cycle of the field.
+ *
+ * The cycle runs along row 0 left to right, snakes through the other rows
+ * over columns 1 to kFieldSize - 1 and returns up column 0. A snake shorter
+ * than the field that follows it never runs into itself.
+ */
+Direction cycleDirection(const Cords& cell) {
+  constexpr int last = kFieldSize - 1;
+  if (cell.y_ == 0) return cell.x_ == last ? Direction::DOWN : Direction::RIGHT;
+  if (cell.x_ == 0) return Direction::UP;
+  if (cell.y_ % 2) {
+    if (cell.x_ > 1) return Direction::LEFT;
+    return cell.y_ == last ? Direction::LEFT : Direction::DOWN;
+  }
+  return cell.x_ < last ? Direction::RIGHT : Direction::DOWN;
+}
+
+/**
+ * @brief Snake model on a clock that never moves, grown to a given length
+ * along the Hamiltonian cycle.
+ */
+class FrozenSnake {
+ public:
+  explicit FrozenSnake(size_t length) : model_(kFieldSize, kFieldSize) {
+    model_.setScoreSaving(false);
+    model_.setClock(&clock_);
+    model_.setSeed(42);
+    model_.setDefault();
+    model_.updateData(UserAction::SPACE_BTN);
+    model_.updateData(UserAction::NO_ACT);
+    /* lay the whole spawned body on the cycle before growing */
+    for (int i = 0; i < 8; ++i) step(false);
+    while (data().snake_coord.size() < length) step(true);
+  }
+
+  FrozenSnake& operator=(const FrozenSnake& other) {
+    model_ = other.model_;
+    model_.setClock(&clock_);
+    return *this;
+  }
+
+  /**
+   * @brief Moves the head to the next cell of the cycle.
+   *
+   * @param eat Whether the fruit is put in that cell.
+   */
+  void step(bool eat) {
+    const Direction direction = cycleDirection(data().snake_coord.front());
+    model_.setFruit(eat ? neighbour(data().snake_coord.front(), direction)
+                        : SnakeModel::kNoFruit);
+    model_.updateData(actionFor(direction));
+  }
+
+  SnakeModel& model() { return model_; }
+  SnakeModel::GameData& data() { return model_.getModelData(); }
+
+ private:
+  VirtualClock clock_;
+  SnakeModel model_;
+};
+
+void BM_SnakeMove(benchmark::State& state) {
+  FrozenSnake game(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    game.step(false);
+  }
+  if (game.data().game_state != GameState::MOVING) {
+    state.SkipWithError("the snake crashed");
+  }
+}
+BENCHMARK(BM_SnakeMove)->Arg(4)->Arg(200)->Arg(10000);
+
+void BM_SnakeEat(benchmark::State& state) {
+  FrozenSnake game(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    game.step(true);
+  }
+  if (game.data().game_state != GameState::MOVING) {
+    state.SkipWithError("the snake crashed");
+  }
+}
+/* every iteration grows the snake, so the count is fixed below the field */
+BENCHMARK(BM_SnakeEat)->Arg(4)->Arg(200)->Arg(10000)->Iterations(2000);
+
+/// The move that ends the game: into the body when a body cell is beside
+/// the head, otherwise into the wall.
+void BM_SnakeCollision(benchmark::State& state) {
+  FrozenSnake base(static_cast<size_t>(state.range(0)));
+  const Cords corner(0, kFieldSize - 2);
+  while (base.data().snake_coord.front() != corner) base.step(false);
+  const Cords right = neighbour(corner, Direction::RIGHT);
+  const bool body = !base.model().getOccupancy().isFree(right.x_, right.y_);
+  const UserAction action =
+      body ? UserAction::RIGHT_BTN : UserAction::LEFT_BTN;
+
+  FrozenSnake game(4);
+  for (auto _ : state) {
+    state.PauseTiming();
+    game = base;
+    state.ResumeTiming();
+    game.model().updateData(action);
+  }
+  if (game.data().game_state != GameState::COLLIDE) {
+    state.SkipWithError("the snake did not crash");
+  }
+  state.SetLabel(body ? "body" : "wall");
+}
+BENCHMARK(BM_SnakeCollision)->Arg(4)->Arg(200)->Arg(10000);
+
+}  // namespace
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/brick_game/tetris/TetrisModel.h"
+
+using namespace s21;
+
+namespace {
+
+const char* const kStateNames[STATES_CNT] = {
+    "START", "SPAWN", "MOVING", "COLLIDE", "PAUSE", "EXIT", "GAMEOVER"};
+
+/**
+ * @brief Tetris model on a clock that never moves, so gravity never fires
+ * and every iteration does exactly the work of the measured action.
+ */
+class FrozenTetris {
+ public:
+  FrozenTetris() {
+    model_.setScoreSaving(false);
+    model_.setClock(&clock_);
+    model_.setSeed(42);
+    restart();
+  }
+
+  /// @brief Starts a new game and skips the start screen.
+  void restart() {
+    model_.setDefault();
+    model_.updateData(UserAction::SPACE_BTN);
+    model_.updateData(UserAction::NO_ACT);
+  }
+
+  TetrisModel& model() { return model_; }
+  TetrisModel::GameData& data() { return model_.getModelData(); }
+
+ private:
+  VirtualClock clock_;
+  TetrisModel model_;
+};
+
+/// @brief Restarts the game outside the timed region once it is lost.
+void restartIfLost(benchmark::State& state, FrozenTetris& game) {
+  if (game.data().game_state != GameState::GAMEOVER) return;
+  state.PauseTiming();
+  game.restart();
+  state.ResumeTiming();
+}
+
+void BM_TetrisUpdateData(benchmark::State& state) {
+  const auto game_state = static_cast<GameState>(state.range(0));
+  FrozenTetris game;
+  for (auto _ : state) {
+    game.data().game_state = game_state;
+    game.model().updateData(UserAction::NO_ACT);
+    if (game_state != GameState::GAMEOVER) restartIfLost(state, game);
+  }
+  state.SetLabel(kStateNames[state.range(0)]);
+}
+BENCHMARK(BM_TetrisUpdateData)->DenseRange(0, STATES_CNT - 1);
+
+void BM_TetrisRotate(benchmark::State& state) {
+  FrozenTetris game;
+  for (auto _ : state) {
+    game.model().updateData(UserAction::UP_BTN);
+    benchmark::DoNotOptimize(game.data().cur_figure);
+  }
+}
+BENCHMARK(BM_TetrisRotate);
+
+void BM_TetrisDrop(benchmark::State& state) {
+  FrozenTetris game;
+  for (auto _ : state) {
+    game.model().updateData(UserAction::SPACE_BTN);
+    restartIfLost(state, game);
+  }
+}
+BENCHMARK(BM_TetrisDrop);
+
+/// Moving the figure sideways recomputes its projection on every step.
+void BM_TetrisProjection(benchmark::State& state) {
+  FrozenTetris game;
+  Board& field = game.data().game_field;
+  for (int col = 0; col < field.width(); ++col) {
+    for (int row = field.height() - 1 - col % 5; row < field.height(); ++row) {
+      field.setCell(row, col, 1);
+    }
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    game.model().updateData(i++ % 8 < 4 ? UserAction::LEFT_BTN
+                                        : UserAction::RIGHT_BTN);
+    benchmark::DoNotOptimize(game.data().projection);
+  }
+}
+BENCHMARK(BM_TetrisProjection);
+
+/// Clearing complete lines with 0 to 4 full rows under a ragged stack. The
+/// board is restored from a copy each time, which the 0 rows case measures.
+void BM_TetrisClearLines(benchmark::State& state) {
+  const int full_rows = static_cast<int>(state.range(0));
+  Board stack;
+  for (int row = stack.height() - 8; row < stack.height(); ++row) {
+    const bool full = row >= stack.height() - full_rows;
+    for (int col = 0; col < stack.width(); ++col) {
+      if (full || col != row % stack.width()) stack.setCell(row, col, 1);
+    }
+  }
+  Board board = stack;
+  for (auto _ : state) {
+    board = stack;
+    benchmark::DoNotOptimize(board.clearFullRows().size());
+  }
+}
+BENCHMARK(BM_TetrisClearLines)->DenseRange(0, 4);
+
+}  // namespace
@@ -1,7 +1,9 @@
 #ifndef BRICKGAME_BASE_CONSTANTS_H_
 #define BRICKGAME_BASE_CONSTANTS_H_
 
-#include <random>
+#include <initializer_list>
+
+#include "Random.h"
 
 namespace s21 {
 
@@ -20,6 +22,12 @@ constexpr int field_width = 10;
 /// The height of the game field
 constexpr int field_height = 20;
 
+/// The smallest width or height of a game field
+constexpr int min_field_size = 8;
+
+/// The largest width or height of a game field
+constexpr int max_field_size = 1024;
+
 /// The size of a pixel for view
 constexpr int pixel_size = 25;
 
@@ -29,9 +37,18 @@ constexpr int console_window_h = 21;
 /// The width of the console window
 constexpr int console_window_w = 22;
 
+/// The width of the console side panel, including its right border
+constexpr int console_panel_w = console_window_w - field_width - 1;
+
 /// The height of the information panel
 constexpr int console_info_panel_h = 7;
 
+/// @brief The period of a view loop iteration in milliseconds
+constexpr int tick_ms = 10;
+
+/// @brief The size of a cache line, keeps data of different threads apart
+constexpr int cache_line_size = 64;
+
 /// @brief The intervals in milliseconds between levels
 static constexpr int levels_intervals_ms[] = {500, 420, 340, 260, 230,
                                               200, 180, 160, 140, 125};
@@ -42,30 +59,19 @@ static constexpr int levels_intervals_ms[] = {500, 420, 340, 260, 230,
  * \brief A struct that represents coordinates in 2D space.
  */
 struct Cords {
-  Cords() : x_(0), y_(0) {}
+  constexpr Cords() : x_(0), y_(0) {}
 
-  explicit Cords(int x, int y) : x_(x), y_(y) {}
+  constexpr explicit Cords(int x, int y) : x_(x), y_(y) {}
 
-  Cords(std::initializer_list<int> list) {
-    auto it = list.begin();
-    x_ = *it++;
-    y_ = *it;
-  }
+  constexpr Cords(std::initializer_list<int> list)
+      : x_(*list.begin()), y_(*(list.begin() + 1)) {}
 
-  bool operator==(const Cords& other) const {
+  constexpr bool operator==(const Cords& other) const {
     return (x_ == other.x_ && y_ == other.y_);
   }
 
-  bool operator!=(const Cords& other) const { return !(*this == other); }
-
-  void randomCords() {
-    std::random_device rd;
-    std::default_random_engine gen(rd());
-    std::uniform_int_distribution<int> width(0, ConstSizes::field_width - 1);
-    std::uniform_int_distribution<int> height(0, ConstSizes::field_height - 1);
-
-    x_ = width(gen);
-    y_ = height(gen);
+  constexpr bool operator!=(const Cords& other) const {
+    return !(*this == other);
   }
 
   int x_;
@@ -1,32 +1,353 @@
 #ifndef BRICKGAME_BASE_MODEL_H_
 #define BRICKGAME_BASE_MODEL_H_
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <random>
+#include <utility>
+#include <vector>
 
 #include "BaseConstants.h"
+#include "Clock.h"
+#include "Random.h"
+#include "SpscQueue.h"
 
 #define STATES_CNT 7
 #define USER_ACTIONS_CNT 9
+#define COMPONENTS_CNT 4
 
 namespace s21 {
+
+/**
+ * @brief Parts of the game data whose changes are tracked separately.
+ */
+enum class ModelComponent {
+  FIELD = 0,  ///< Game field: locked cells, snake body, fruit
+  FIGURE,     ///< Current, next and projected figures
+  HUD,        ///< Score, best score and level
+  STATE       ///< Game state
+};
+
+/**
+ * @brief Values shown next to the game field.
+ */
+enum class HudItem { SCORE = 0, BEST_SCORE, LEVEL, NEXT_FIGURE };
+
+/**
+ * @brief A field cell whose content changed, with its new color.
+ */
+struct CellChange {
+  Cords cell;  ///< Column and row of the cell
+  int color;   ///< Color index of the cell, 0 for an empty cell
+};
+
+/**
+ * @brief A user action with the time it was performed.
+ */
+struct InputEvent {
+  UserAction action{};  ///< The action performed by the user
+  long long time{};     ///< Time of the action in milliseconds
+};
+
+/// @brief Queue of input events from a view to the thread ticking the model.
+/// It has a single producer, so the events come out in the order they were
+/// performed.
+using InputQueue = SpscQueue<InputEvent, 64>;
+
+/**
+ * @brief Changes of the model collected since the previous drain.
+ */
+struct ChangeLog {
+  bool full_redraw{};             ///< Every cell and HUD item changed
+  unsigned hud{};                 ///< Mask of changed HUD items, see hudBit()
+  std::vector<CellChange> cells;  ///< Changed cells, each listed once
+};
+
 /**
  * @brief Base model class that provides some common functionality.
+ *
+ * Every model carries a monotonically increasing version. Mutators call
+ * touch() for the component they change, which stamps it with the next
+ * version, so views can ask what changed since the version they last drew.
+ *
+ * Models also log the field cells and HUD items they change. Renderers and
+ * recorders drain that log to redraw only what changed since the last drain.
  */
 class BaseModel {
  public:
+  /// @brief A version of the model data.
+  using Version = unsigned long long;
+
+  /// @brief Deadline of a model that only changes on input.
+  static constexpr long long kNoDeadline =
+      std::numeric_limits<long long>::max();
+
+  /**
+   * @brief Constructs the model with a seed drawn from std::random_device.
+   */
+  BaseModel() { setSeed(std::random_device{}()); }
+
+  virtual ~BaseModel() = default;
+
+  /**
+   * @brief Restarts the random sequence of the model from a seed.
+   *
+   * A game started with setDefault() after the same seed and fed the same
+   * actions on the same clock plays out identically.
+   *
+   * @param seed The seed of the sequence.
+   */
+  void setSeed(std::uint64_t seed) {
+    seed_ = seed;
+    rng_.seed(seed);
+  }
+
+  /**
+   * @brief Get the seed the random sequence was last started from.
+   *
+   * @return std::uint64_t The seed.
+   */
+  std::uint64_t getSeed() const { return seed_; }
+
+  /**
+   * @brief Enables or disables saving the best score when the model is
+   * destroyed. Headless runs turn it off so that they leave no score file
+   * behind.
+   *
+   * @param enabled Whether the destructor writes the best score.
+   */
+  void setScoreSaving(bool enabled) { save_score_ = enabled; }
+
+  /**
+   * @brief Checks whether the best score is saved when the model is destroyed.
+   *
+   * @return true if the destructor writes the best score; false otherwise.
+   */
+  bool isScoreSaving() const { return save_score_; }
+
+  /**
+   * @brief Gets the width of the game field.
+   *
+   * @return The number of columns.
+   */
+  int getFieldWidth() const { return field_width_; }
+
+  /**
+   * @brief Gets the height of the game field.
+   *
+   * @return The number of rows.
+   */
+  int getFieldHeight() const { return field_height_; }
+
+  /**
+   * @brief Brings a requested field size into the supported range.
+   *
+   * @param size The requested number of columns or rows.
+   * @return The size clamped to [min_field_size, max_field_size].
+   */
+  static constexpr int fitFieldSize(int size) {
+    return size < ConstSizes::min_field_size   ? ConstSizes::min_field_size
+           : size > ConstSizes::max_field_size ? ConstSizes::max_field_size
+                                               : size;
+  }
+
+  /**
+   * @brief Gets the bit of a HUD item in a change mask.
+   *
+   * @param item The HUD item.
+   * @return The bit representing the item.
+   */
+  static constexpr unsigned hudBit(HudItem item) {
+    return 1u << static_cast<unsigned>(item);
+  }
+
+  /**
+   * @brief Gets the color of a field cell as it should be drawn.
+   *
+   * @param x The column of the cell.
+   * @param y The row of the cell.
+   * @return The color index of the cell, 0 for an empty cell.
+   */
+  virtual int getCellColor(int x, int y) const = 0;
+
+  /**
+   * @brief Collects the changes logged since the previous drain.
+   *
+   * @return Reference to the change log, valid until the next drain.
+   */
+  const ChangeLog& drainChanges() {
+    drained_.full_redraw = pending_full_;
+    drained_.hud = pending_hud_;
+    drained_.cells.clear();
+    for (const auto& cell : pending_cells_) {
+      marked_[static_cast<size_t>(cell.y_) * field_width_ + cell.x_] = false;
+      if (!pending_full_) {
+        drained_.cells.push_back({cell, getCellColor(cell.x_, cell.y_)});
+      }
+    }
+    pending_cells_.clear();
+    pending_full_ = false;
+    pending_hud_ = 0;
+    return drained_;
+  }
+
+  /**
+   * @brief Gets the bit of a component in a change mask.
+   *
+   * @param component The component.
+   * @return The bit representing the component.
+   */
+  static constexpr unsigned componentBit(ModelComponent component) {
+    return 1u << static_cast<unsigned>(component);
+  }
+
+  /**
+   * @brief Get the current version of the model data.
+   *
+   * @return Version The latest version stamped on any component.
+   */
+  Version getVersion() const { return version_; }
+
+  /**
+   * @brief Get the version at which a component last changed.
+   *
+   * @param component The component to query.
+   * @return Version The version of the component.
+   */
+  Version getVersion(ModelComponent component) const {
+    return versions_[static_cast<size_t>(component)];
+  }
+
+  /**
+   * @brief Get the components that changed after a given version.
+   *
+   * @param version The version the caller has already seen.
+   * @return unsigned The mask of changed components, see componentBit().
+   */
+  unsigned changedSince(Version version) const {
+    unsigned mask = 0;
+    for (size_t i = 0; i < COMPONENTS_CNT; ++i) {
+      if (versions_[i] > version) mask |= 1u << i;
+    }
+    return mask;
+  }
+
+  /**
+   * @brief Updates the game data based on the user's action.
+   *
+   * @param action The action performed by the user.
+   */
+  virtual void updateData(UserAction action) = 0;
+
+  /**
+   * @brief Applies every queued event at the time it was performed, so no
+   * key pressed since the previous tick is lost and the timed steps due
+   * before a key, such as a gravity step, are taken before it. A tick
+   * without input is an update with UserAction::NO_ACT.
+   *
+   * The handler of an event sees the model clock read the time of the
+   * event. The times are clamped to the span since the previous tick, so
+   * events stamped on a clock other than the model's are applied at the
+   * time of the tick.
+   *
+   * @param input The queue to drain. The caller must be its only consumer.
+   * @return The number of events applied.
+   */
+  size_t applyInput(InputQueue& input) {
+    Clock* const source = clock_.getSource();
+    const long long now = source->now();
+    const long long since = std::min(input_time_, now);
+    input_time_ = now;
+
+    VirtualClock& event_clock = clock_.getVirtual();
+    InputEvent event;
+    size_t count = 0;
+    /* a producer pushing meanwhile waits for the next tick */
+    while (count < InputQueue::kCapacity && input.pop(event)) {
+      event_clock.set(std::clamp(event.time, since, now));
+      clock_.setSource(&event_clock);
+      runTimedSteps(event_clock.now());
+      updateData(event.action);
+      ++count;
+    }
+    clock_.setSource(source);
+    if (count == 0) {
+      updateData(UserAction::NO_ACT);
+    } else {
+      runTimedSteps(now);
+    }
+    return count;
+  }
+
+  /**
+   * @brief Resets the game data to its default values.
+   */
+  virtual void setDefault() = 0;
+
+  /**
+   * @brief Gets the time at which the model next changes on its own, such
+   * as the next gravity step or snake move.
+   *
+   * @return The time in milliseconds on the model clock, or kNoDeadline
+   * while the model waits for input only, as on the start and pause screens.
+   */
+  virtual long long getNextDeadline() const = 0;
+
   /**
-   * @brief Get current time in milliseconds.
+   * @brief Gets the time left until the next deadline.
+   *
+   * @return The milliseconds to wait, 0 if the deadline has passed, or
+   * kNoDeadline if there is none.
+   */
+  long long getTimeToDeadline() const {
+    const long long deadline = getNextDeadline();
+    if (deadline == kNoDeadline) return kNoDeadline;
+    return std::max(0LL, deadline - getCurTime());
+  }
+
+  /**
+   * @brief Get current time in milliseconds from the model clock.
    *
    * @return long long The current time in milliseconds.
    */
-  static long long getCurTime() {
-    auto now = std::chrono::system_clock::now();
-    auto duration = now.time_since_epoch();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
-    return ms.count();
+  long long getCurTime() const { return clock_.now(); }
+
+  /**
+   * @brief Set the source of time of the model.
+   *
+   * @param clock The clock to read, or nullptr for the steady clock. The model
+   * does not take ownership.
+   */
+  void setClock(Clock* clock) { clock_.setSource(clock); }
+
+  /**
+   * @brief Advance the model through simulated ticks without sleeping.
+   *
+   * For the duration of the call the model runs on its own virtual clock,
+   * starting from the time of the current clock, and every tick moves it
+   * ConstSizes::tick_ms forward before calling updateData(). The current
+   * clock is restored on return and the times kept by the model are shifted
+   * onto it, so a real-time front-end carries on where the steps left off.
+   *
+   * @param actions The action for each tick. Ticks past the end of the list
+   * get UserAction::NO_ACT.
+   * @param ticks The number of ticks to simulate.
+   */
+  void step(const std::vector<UserAction>& actions, size_t ticks) {
+    Clock* const source = clock_.getSource();
+    VirtualClock& sim_clock = clock_.getVirtual();
+    sim_clock.set(source->now());
+    clock_.setSource(&sim_clock);
+    for (size_t i = 0; i < ticks; ++i) {
+      sim_clock.advance(ConstSizes::tick_ms);
+      updateData(i < actions.size() ? actions[i] : UserAction::NO_ACT);
+    }
+    clock_.setSource(source);
+    shiftTime(source->now() - sim_clock.now());
   }
 
   /**
@@ -58,6 +379,105 @@ class BaseModel {
       file.close();
     }
   }
+
+ protected:
+  Random rng_;  ///< Random sequence of the model
+
+  /**
+   * @brief Moves every time the model keeps by an offset. step() calls it
+   * when it hands the model back to a clock that reads differently from the
+   * simulated one.
+   *
+   * @param delta The offset in milliseconds.
+   */
+  virtual void shiftTime(long long delta) { (void)delta; }
+
+  /**
+   * @brief Takes the timed steps of the game due by a time, such as gravity
+   * steps or snake moves, without an action. applyInput() calls it so that
+   * the steps due before a queued action come first.
+   *
+   * @param time The time in milliseconds on the model clock.
+   */
+  virtual void runTimedSteps(long long time) { (void)time; }
+
+  /**
+   * @brief Marks a component as changed by stamping it with a new version.
+   *
+   * @param component The component that changed.
+   */
+  void touch(ModelComponent component) {
+    versions_[static_cast<size_t>(component)] = ++version_;
+  }
+
+  /**
+   * @brief Marks every component as changed.
+   */
+  void touchAll() {
+    ++version_;
+    for (auto& v : versions_) v = version_;
+  }
+
+  /**
+   * @brief Sets the size of the field and sizes the cell change log for it.
+   *
+   * @param width The number of columns of the field.
+   * @param height The number of rows of the field.
+   */
+  void initChangeLog(int width, int height) {
+    field_width_ = width;
+    field_height_ = height;
+    marked_.assign(static_cast<size_t>(width) * height, false);
+    pending_cells_.reserve(marked_.size());
+    drained_.cells.reserve(marked_.size());
+    markAll();
+  }
+
+  /**
+   * @brief Logs a field cell as changed. Cells outside the field are ignored.
+   *
+   * @param x The column of the cell.
+   * @param y The row of the cell.
+   */
+  void markCell(int x, int y) {
+    if (x < 0 || y < 0 || x >= field_width_ || y >= field_height_) return;
+    const size_t idx = static_cast<size_t>(y) * field_width_ + x;
+    if (marked_[idx]) return;
+    marked_[idx] = true;
+    pending_cells_.push_back(Cords(x, y));
+  }
+
+  /**
+   * @brief Logs a HUD item as changed.
+   *
+   * @param item The HUD item that changed.
+   */
+  void markHud(HudItem item) { pending_hud_ |= hudBit(item); }
+
+  /**
+   * @brief Logs every cell and HUD item as changed.
+   */
+  void markAll() {
+    pending_full_ = true;
+    pending_hud_ = ~0u;
+  }
+
+ private:
+  std::uint64_t seed_{};    ///< Seed of rng_
+  bool save_score_ = true;  ///< Best score saved on exit
+  ModelClock clock_;        ///< Source of time, virtual during step()
+  long long input_time_{};  ///< Time of the previous applyInput()
+
+  Version version_{};                   ///< Latest version of the model
+  Version versions_[COMPONENTS_CNT]{};  ///< Last version of each component
+
+  int field_width_{};                 ///< Width of the game field
+  int field_height_{};                ///< Height of the game field
+  std::vector<bool> marked_;          ///< Cells already in the pending log
+  std::vector<Cords> pending_cells_;  ///< Cells changed since the last drain
+  unsigned pending_hud_{};            ///< HUD items changed since last drain
+  bool pending_full_{};               ///< Full redraw pending
+  ChangeLog drained_;                 ///< Log handed out by the last drain
 };
 
 /**
@@ -66,7 +486,8 @@ class BaseModel {
  * A state-action matrix maps a state and an action to a function pointer.
  * This class is templated on a model, and stores the function pointers in a
  * 2D array, where the first dimension is the state, and the second dimension
- * is the action.
+ * is the action. It can be filled in a constexpr function, so a model can
+ * declare its matrix as a compile-time constant.
  */
 template <typename Model>
 class StateActionMatrix {
@@ -88,13 +509,13 @@ class StateActionMatrix {
     /// @brief Constructs a Proxy object.
     ///
     /// @param row The row of the matrix to proxy.
-    explicit Proxy(Action* row) : row(row) {}
+    constexpr explicit Proxy(Action* row) : row(row) {}
 
     /// @brief Returns the function pointer for a given action.
     ///
     /// @param action The action to access.
     /// @return The function pointer for the action.
-    Action& operator[](UserAction action) {
+    constexpr Action& operator[](UserAction action) {
       return row[static_cast<size_t>(action)];
     }
 
@@ -102,11 +523,31 @@ class StateActionMatrix {
     ///
     /// @param action The index to access.
     /// @return The function pointer for the index.
-    Action& operator[](int action) { return row[action]; }
+    constexpr Action& operator[](int action) { return row[action]; }
+  };
+
+  /// @brief A read-only proxy class for accessing the function pointer matrix.
+  class ConstProxy {
+   private:
+    const Action* row;
+
+   public:
+    /// @brief Constructs a ConstProxy object.
+    ///
+    /// @param row The row of the matrix to proxy.
+    constexpr explicit ConstProxy(const Action* row) : row(row) {}
+
+    /// @brief Returns the function pointer for a given action.
+    ///
+    /// @param action The action to access.
+    /// @return The function pointer for the action.
+    constexpr Action operator[](UserAction action) const {
+      return row[static_cast<size_t>(action)];
+    }
   };
 
  public:
-  StateActionMatrix() {
+  constexpr StateActionMatrix() {
     for (int i = 0; i < STATES_CNT; i++) {
       for (int j = 0; j < USER_ACTIONS_CNT; j++) {
         matrix[i][j] = nullptr;
@@ -118,10 +559,102 @@ class StateActionMatrix {
   ///
   /// @param state The state to access.
   /// @return The Proxy object for the state.
-  Proxy operator[](GameState state) {
+  constexpr Proxy operator[](GameState state) {
     return Proxy(matrix[static_cast<size_t>(state)]);
   }
+
+  /// @brief Returns a read-only proxy object for a given state.
+  ///
+  /// @param state The state to access.
+  /// @return The ConstProxy object for the state.
+  constexpr ConstProxy operator[](GameState state) const {
+    return ConstProxy(matrix[static_cast<size_t>(state)]);
+  }
+
+  /// @brief Returns the function pointer at a flat index.
+  ///
+  /// @param idx The index, state * USER_ACTIONS_CNT + action.
+  /// @return The function pointer at the index.
+  constexpr Action at(size_t idx) const {
+    return matrix[idx / USER_ACTIONS_CNT][idx % USER_ACTIONS_CNT];
+  }
+
+  /// @brief Returns the flat index of a state and an action.
+  ///
+  /// @param state The state.
+  /// @param action The action.
+  /// @return The index, state * USER_ACTIONS_CNT + action.
+  static constexpr size_t index(GameState state, UserAction action) {
+    return static_cast<size_t>(state) * USER_ACTIONS_CNT +
+           static_cast<size_t>(action);
+  }
 };
+
+/**
+ * @brief Dispatcher over a state-action matrix known at compile time.
+ *
+ * Every cell of the matrix becomes a plain function that calls its handler
+ * directly, so the compiler can inline the handler into it. The functions
+ * are laid out in a constant table indexed by the cell, and a dispatch is
+ * one indirect call through it instead of a call through a member function
+ * pointer. Empty cells do nothing, as with the runtime matrix.
+ *
+ * @tparam Model The model the handlers belong to.
+ * @tparam Matrix The constexpr matrix of the model.
+ */
+template <typename Model, const StateActionMatrix<Model>& Matrix>
+class StateActionDispatcher {
+ public:
+  /// @brief Calls the handler of a state and an action, if any.
+  ///
+  /// @param model The model to call the handler on.
+  /// @param state The current state.
+  /// @param action The user action.
+  static void dispatch(Model* model, GameState state, UserAction action) {
+    kThunks[StateActionMatrix<Model>::index(state, action)](model);
+  }
+
+  /// @brief Calls the handler of a state and an action, if any, through a
+  /// member pointer read from the matrix at run time. This is the dispatch
+  /// the table replaced, kept for the benchmarks.
+  ///
+  /// @param model The model to call the handler on.
+  /// @param state The current state.
+  /// @param action The user action.
+  static void dispatchRuntime(Model* model, GameState state,
+                              UserAction action) {
+    const auto handler = Matrix[state][action];
+    if (handler) (model->*handler)();
+  }
+
+ private:
+  /// @brief The function calling the handler of one cell.
+  using Thunk = void (*)(Model*);
+
+  /// @brief The number of cells of the matrix.
+  static constexpr size_t kCells = STATES_CNT * USER_ACTIONS_CNT;
+
+  /// @brief The function of every cell, by its flat index.
+  static const std::array<Thunk, kCells> kThunks;
+
+  template <size_t I>
+  static void call(Model* model) {
+    constexpr auto handler = Matrix.at(I);
+    if constexpr (handler != nullptr) (model->*handler)();
+  }
+
+  template <size_t... I>
+  static constexpr std::array<Thunk, kCells> makeThunks(
+      std::index_sequence<I...>) {
+    return {{&call<I>...}};
+  }
+};
+
+template <typename Model, const StateActionMatrix<Model>& Matrix>
+constexpr std::array<typename StateActionDispatcher<Model, Matrix>::Thunk,
+                     StateActionDispatcher<Model, Matrix>::kCells>
+    StateActionDispatcher<Model, Matrix>::kThunks =
+        makeThunks(std::make_index_sequence<kCells>{});
 }  // namespace s21
 
 #endif
\ No newline at end of file
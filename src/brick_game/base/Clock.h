@@ -0,0 +1,144 @@
+#ifndef BRICKGAME_BASE_CLOCK_H_
+#define BRICKGAME_BASE_CLOCK_H_
+
+#include <chrono>
+
+namespace s21 {
+
+/**
+ * @brief Source of time for the models, in milliseconds.
+ */
+class Clock {
+ public:
+  virtual ~Clock() = default;
+
+  /**
+   * @brief Get the current time in milliseconds.
+   *
+   * @return long long The current time in milliseconds.
+   */
+  virtual long long now() const = 0;
+};
+
+/**
+ * @brief Clock backed by std::chrono::steady_clock.
+ *
+ * It never jumps when the wall-clock time is adjusted, which makes it the
+ * default source of time for gravity and movement.
+ */
+class SteadyClock : public Clock {
+ public:
+  long long now() const override {
+    auto duration = std::chrono::steady_clock::now().time_since_epoch();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+    return ms.count();
+  }
+
+  /**
+   * @brief Get the process-wide steady clock instance.
+   *
+   * @return SteadyClock& The shared instance.
+   */
+  static SteadyClock& instance() {
+    static SteadyClock clock;
+    return clock;
+  }
+};
+
+/**
+ * @brief Manually advanced clock for deterministic headless simulation.
+ */
+class VirtualClock : public Clock {
+ public:
+  /**
+   * @brief Constructs a virtual clock.
+   *
+   * @param start The initial time in milliseconds.
+   */
+  explicit VirtualClock(long long start = 0) : now_(start) {}
+
+  long long now() const override { return now_; }
+
+  /**
+   * @brief Set the current time.
+   *
+   * @param ms The new time in milliseconds.
+   */
+  void set(long long ms) { now_ = ms; }
+
+  /**
+   * @brief Move the current time forward.
+   *
+   * @param ms The number of milliseconds to advance.
+   */
+  void advance(long long ms) { now_ += ms; }
+
+ private:
+  long long now_;  ///< The current time in milliseconds
+};
+
+/**
+ * @brief Clock of a model: the source of time set by its owner, or a
+ * virtual clock the model drives itself while it simulates ticks.
+ *
+ * A copy reads the same source, except that a copy of a model running on
+ * its own virtual clock runs on its own copy of it, never on the source's.
+ */
+class ModelClock : public Clock {
+ public:
+  ModelClock() = default;
+
+  ModelClock(const ModelClock& other)
+      : virtual_(other.virtual_), source_(other.rebound(virtual_)) {}
+
+  ModelClock& operator=(const ModelClock& other) {
+    virtual_ = other.virtual_;
+    source_ = other.rebound(virtual_);
+    return *this;
+  }
+
+  long long now() const override { return source_->now(); }
+
+  /**
+   * @brief Get the source of time.
+   *
+   * @return Clock* The clock read by now().
+   */
+  Clock* getSource() const { return source_; }
+
+  /**
+   * @brief Set the source of time.
+   *
+   * @param clock The clock to read, or nullptr for the steady clock. It is
+   * not owned.
+   */
+  void setSource(Clock* clock) {
+    source_ = clock ? clock : &SteadyClock::instance();
+  }
+
+  /**
+   * @brief Get the virtual clock of the model.
+   *
+   * @return VirtualClock& The clock the model drives itself.
+   */
+  VirtualClock& getVirtual() { return virtual_; }
+
+ private:
+  VirtualClock virtual_;                      ///< Clock driven by the model
+  Clock* source_ = &SteadyClock::instance();  ///< Source of time
+
+  /**
+   * @brief Gets the source a copy reads.
+   *
+   * @param own_virtual The virtual clock of the copy.
+   * @return Clock* The source, with the virtual clock of this object
+   * replaced by the one of the copy.
+   */
+  Clock* rebound(VirtualClock& own_virtual) const {
+    return source_ == &virtual_ ? &own_virtual : source_;
+  }
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_BASE_CLOCK_H_
@@ -0,0 +1,119 @@
+#ifndef BRICKGAME_BASE_FIXED_TIMESTEP_H_
+#define BRICKGAME_BASE_FIXED_TIMESTEP_H_
+
+namespace s21 {
+
+/**
+ * @brief Accumulator turning elapsed time into whole steps of a fixed
+ * interval.
+ *
+ * Every elapsed interval is one step, however late the update comes, and
+ * the time left over after the last whole step carries over to the next
+ * update. Speed therefore does not drift with the loop jitter, and an
+ * interval shorter than the update period gives several steps per update.
+ */
+class FixedTimestep {
+ public:
+  /// @brief Most steps one update catches up on, older time is dropped.
+  static constexpr long long kMaxCatchUp = 32;
+
+  /**
+   * @brief Starts counting a new step from a moment.
+   *
+   * @param now The current time in milliseconds.
+   */
+  void restart(long long now) {
+    start_ = now;
+    paused_ = false;
+  }
+
+  /**
+   * @brief Sets the length of a step. The step in progress keeps its start.
+   *
+   * @param interval The step length in milliseconds, positive.
+   */
+  void setInterval(long long interval) { interval_ = interval; }
+
+  /**
+   * @brief Gets the length of a step.
+   *
+   * @return The step length in milliseconds.
+   */
+  long long getInterval() const { return interval_; }
+
+  /**
+   * @brief Gets the time the step in progress is due.
+   *
+   * @return The time in milliseconds.
+   */
+  long long getDeadline() const { return start_ + interval_; }
+
+  /**
+   * @brief Takes the next elapsed step, if any. Call in a loop to apply
+   * every step due by now.
+   *
+   * @param now The current time in milliseconds.
+   * @return true if a step was due; false otherwise.
+   */
+  bool step(long long now) {
+    if (paused_ || now - start_ < interval_) return false;
+    start_ += interval_;
+    return true;
+  }
+
+  /**
+   * @brief Drops the time beyond kMaxCatchUp steps, so that an update after
+   * a long stall does not replay all of it. Call before the steps of an
+   * update.
+   *
+   * @param now The current time in milliseconds.
+   */
+  void limitBacklog(long long now) {
+    if (now - start_ > kMaxCatchUp * interval_) {
+      start_ = now - kMaxCatchUp * interval_;
+    }
+  }
+
+  /**
+   * @brief Stops the time of the step in progress.
+   *
+   * @param now The current time in milliseconds.
+   */
+  void pause(long long now) {
+    if (paused_) return;
+    paused_ = true;
+    paused_at_ = now;
+  }
+
+  /**
+   * @brief Lets the time of the step in progress run again from where it
+   * was paused.
+   *
+   * @param now The current time in milliseconds.
+   */
+  void resume(long long now) {
+    if (!paused_) return;
+    paused_ = false;
+    start_ += now - paused_at_;
+  }
+
+  /**
+   * @brief Moves the steps onto a clock that reads differently.
+   *
+   * @param delta The offset of the new clock from the old one.
+   */
+  void shift(long long delta) {
+    start_ += delta;
+    paused_at_ += delta;
+  }
+
+ private:
+  long long start_{};      ///< Start of the step in progress
+  long long interval_{1};  ///< Length of a step
+  long long paused_at_{};  ///< Time the steps were paused
+  bool paused_{};          ///< No step is taken while paused
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_BASE_FIXED_TIMESTEP_H_
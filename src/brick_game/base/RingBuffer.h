@@ -0,0 +1,153 @@
+#ifndef BRICKGAME_BASE_RING_BUFFER_H_
+#define BRICKGAME_BASE_RING_BUFFER_H_
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Fixed-capacity double-ended ring buffer.
+ *
+ * Storage is allocated once by reserve() and rounded up to a power of two,
+ * so pushing to the front and popping from the back are O(1) index updates
+ * and element i is found with a mask instead of a division. Element 0 is the
+ * front.
+ *
+ * @tparam T The element type.
+ */
+template <typename T>
+class RingBuffer {
+ public:
+  /**
+   * @brief Read-only forward iterator from the front to the back.
+   */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator(const RingBuffer* buffer, size_t i)
+        : buffer_(buffer), i_(i) {}
+
+    reference operator*() const { return (*buffer_)[i_]; }
+    pointer operator->() const { return &(*buffer_)[i_]; }
+
+    const_iterator& operator++() {
+      ++i_;
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator tmp = *this;
+      ++i_;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return i_ == other.i_;
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    const RingBuffer* buffer_;
+    size_t i_;
+  };
+
+  /**
+   * @brief Empties the buffer and makes room for at least a given number of
+   * elements. Storage is only reallocated when it grows.
+   *
+   * @param capacity The minimum number of elements the buffer must hold.
+   */
+  void reserve(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    if (size > data_.size()) data_.resize(size);
+    mask_ = data_.size() - 1;
+    clear();
+  }
+
+  /**
+   * @brief Removes every element, keeping the storage.
+   */
+  void clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  /**
+   * @brief Inserts an element before the front.
+   *
+   * @param value The element to insert.
+   */
+  void push_front(const T& value) {
+    head_ = (head_ - 1) & mask_;
+    data_[head_] = value;
+    ++size_;
+  }
+
+  /**
+   * @brief Inserts an element after the back.
+   *
+   * @param value The element to insert.
+   */
+  void push_back(const T& value) {
+    data_[(head_ + size_) & mask_] = value;
+    ++size_;
+  }
+
+  /**
+   * @brief Removes the back element.
+   */
+  void pop_back() { --size_; }
+
+  T& operator[](size_t i) { return data_[(head_ + i) & mask_]; }
+  const T& operator[](size_t i) const { return data_[(head_ + i) & mask_]; }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+
+  T& back() { return (*this)[size_ - 1]; }
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return data_.size(); }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  /**
+   * @brief Equality operator comparing the elements in order.
+   *
+   * @param other The other buffer to compare with.
+   * @return true if both buffers hold equal elements; false otherwise.
+   */
+  bool operator==(const RingBuffer& other) const {
+    if (size_ != other.size_) return false;
+    for (size_t i = 0; i < size_; ++i) {
+      if ((*this)[i] != other[i]) return false;
+    }
+    return true;
+  }
+
+  bool operator!=(const RingBuffer& other) const { return !(*this == other); }
+
+ private:
+  std::vector<T> data_;  ///< Storage, its size is a power of two
+  size_t mask_{};        ///< Storage size minus one
+  size_t head_{};        ///< Storage index of the front element
+  size_t size_{};        ///< Number of elements
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_BASE_RING_BUFFER_H_
@@ -0,0 +1,94 @@
+#ifndef BRICKGAME_BASE_SPSC_QUEUE_H_
+#define BRICKGAME_BASE_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+
+#include "BaseConstants.h"
+
+namespace s21 {
+
+/**
+ * @brief Bounded lock-free queue between one producer thread and one
+ * consumer thread.
+ *
+ * The slots form a ring of a power-of-two size. The producer only writes
+ * the tail and the consumer only writes the head, each publishing with a
+ * release store, so neither side waits for the other. Both sides keep a
+ * cached copy of the other's index and reload it only when the ring looks
+ * full or empty, so the shared lines are touched once per batch rather than
+ * once per element.
+ *
+ * @tparam T The element type, copy-assignable.
+ * @tparam Capacity The number of slots, a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity && (Capacity & (Capacity - 1)) == 0,
+                "the capacity must be a power of two");
+
+ public:
+  /// @brief The number of elements the queue holds.
+  static constexpr size_t kCapacity = Capacity;
+
+  /**
+   * @brief Appends an element. Producer side.
+   *
+   * @param value The element to append.
+   * @return true if the element was queued; false if the queue is full.
+   */
+  bool push(const T& value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == Capacity) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == Capacity) return false;
+    }
+    slots_[tail & (Capacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest element. Consumer side.
+   *
+   * @param value Receives the element.
+   * @return true if an element was taken; false if the queue is empty.
+   */
+  bool pop(T& value) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) return false;
+    }
+    value = slots_[head & (Capacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Checks whether the queue is empty. Exact on the consumer side,
+   * a hint anywhere else.
+   *
+   * @return true if no element is queued; false otherwise.
+   */
+  bool empty() const {
+    return head_.load(std::memory_order_relaxed) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  /// Next slot to read and the consumer's copy of the tail
+  alignas(ConstSizes::cache_line_size) std::atomic<size_t> head_{};
+  size_t tail_cache_{};
+
+  /// Next slot to write and the producer's copy of the head
+  alignas(ConstSizes::cache_line_size) std::atomic<size_t> tail_{};
+  size_t head_cache_{};
+
+  /// The ring of elements
+  alignas(ConstSizes::cache_line_size) T slots_[Capacity]{};
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_BASE_SPSC_QUEUE_H_
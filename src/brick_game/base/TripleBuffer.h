@@ -0,0 +1,97 @@
+#ifndef BRICKGAME_BASE_TRIPLE_BUFFER_H_
+#define BRICKGAME_BASE_TRIPLE_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "BaseConstants.h"
+
+namespace s21 {
+
+/**
+ * @brief Lock-free exchange of the latest value between one writer thread
+ * and one reader thread.
+ *
+ * The writer fills the back slot and publishes it, the reader picks up the
+ * newest published slot into the front. The third slot sits in the middle
+ * and is the only one both sides touch, swapped with a single atomic
+ * exchange, so neither side ever waits for the other and the reader always
+ * sees a complete value. Values published faster than the reader looks are
+ * skipped, not queued.
+ *
+ * @tparam T The value type, copy-assignable.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  /**
+   * @brief Sets every slot to a value. Neither side may be running.
+   *
+   * @param value The value the reader sees until the first publish.
+   */
+  void reset(const T& value) {
+    for (auto& slot : slots_) slot.value = value;
+    back_ = 0;
+    middle_.store(1, std::memory_order_relaxed);
+    front_ = 2;
+  }
+
+  /**
+   * @brief Gets the slot the writer fills next.
+   *
+   * @return Reference to the back slot, owned by the writer until publish().
+   */
+  T& back() { return slots_[back_].value; }
+
+  /**
+   * @brief Hands the back slot over to the reader. Writer side.
+   */
+  void publish() {
+    back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) &
+            kIndex;
+  }
+
+  /**
+   * @brief Picks up the latest published slot, if there is a new one.
+   * Reader side.
+   *
+   * @return true if the front slot changed; false otherwise.
+   */
+  bool update() {
+    if (!(middle_.load(std::memory_order_relaxed) & kFresh)) return false;
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+    return true;
+  }
+
+  /**
+   * @brief Gets the value the reader picked up last.
+   *
+   * @return Reference to the front slot, valid until the next update().
+   */
+  const T& front() const { return slots_[front_].value; }
+
+ private:
+  static constexpr std::uint8_t kIndex = 3;  ///< Bits of the slot index
+  static constexpr std::uint8_t kFresh = 4;  ///< Middle slot not read yet
+
+  /// @brief A value on cache lines of its own.
+  struct alignas(ConstSizes::cache_line_size) Slot {
+    T value;  ///< The value
+  };
+
+  /* the slots and the indices sit on lines of their own, so the writer
+     filling its slot never shares a line with the reader */
+
+  Slot slots_[3];  ///< The three values
+
+  /// Slot of the writer
+  alignas(ConstSizes::cache_line_size) std::uint8_t back_ = 0;
+  /// Slot in transit, with kFresh set until the reader takes it
+  alignas(ConstSizes::cache_line_size) std::atomic<std::uint8_t> middle_{1};
+  /// Slot of the reader
+  alignas(ConstSizes::cache_line_size) std::uint8_t front_ = 2;
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_BASE_TRIPLE_BUFFER_H_
@@ -0,0 +1,84 @@
+#ifndef BRICKGAME_SELFPLAY_SELF_PLAY_POLICIES_H_
+#define BRICKGAME_SELFPLAY_SELF_PLAY_POLICIES_H_
+
+#include <utility>
+#include <vector>
+
+#include "../snake/SnakeModel.h"
+#include "../tetris/TetrisModel.h"
+#include "SelfPlayRunner.h"
+
+namespace s21 {
+
+/**
+ * @brief Builds a policy choosing one of a set of actions uniformly.
+ *
+ * @tparam Model The model the policy plays.
+ * @param actions The actions to choose from, not empty.
+ * @return The policy.
+ */
+template <typename Model>
+typename SelfPlayRunner<Model>::Policy randomPolicy(
+    std::vector<UserAction> actions) {
+  return [actions = std::move(actions)](const typename Model::GameData&,
+                                        Random& rng) {
+    return actions[rng.uniform(0, static_cast<int>(actions.size()) - 1)];
+  };
+}
+
+/**
+ * @brief Builds a policy pressing a random game key of Tetris, leaving out
+ * pause and exit.
+ *
+ * @return The policy.
+ */
+inline SelfPlayRunner<TetrisModel>::Policy randomTetrisPolicy() {
+  return randomPolicy<TetrisModel>(
+      {UserAction::NO_ACT, UserAction::UP_BTN, UserAction::DOWN_BTN,
+       UserAction::LEFT_BTN, UserAction::RIGHT_BTN, UserAction::SPACE_BTN});
+}
+
+/**
+ * @brief Builds a policy turning the snake to a random side, leaving out
+ * pause and exit.
+ *
+ * @return The policy.
+ */
+inline SelfPlayRunner<SnakeModel>::Policy randomSnakePolicy() {
+  return randomPolicy<SnakeModel>({UserAction::NO_ACT, UserAction::UP_BTN,
+                                   UserAction::DOWN_BTN, UserAction::LEFT_BTN,
+                                   UserAction::RIGHT_BTN});
+}
+
+/**
+ * @brief Builds a policy heading the snake straight for the fruit.
+ *
+ * The snake turns once it is level with the fruit and never looks at its
+ * own body, so it bites itself sooner or later. It is a cheap baseline that
+ * scores more than random play.
+ *
+ * @return The policy.
+ */
+inline SelfPlayRunner<SnakeModel>::Policy greedySnakePolicy() {
+  return [](const SnakeModel::GameData& data, Random&) {
+    const Cords& head = data.snake_coord.front();
+    const int dx = data.fruit_coord.x_ - head.x_;
+    const int dy = data.fruit_coord.y_ - head.y_;
+
+    if (data.direction == Direction::LEFT ||
+        data.direction == Direction::RIGHT) {
+      if (dy != 0) return dy < 0 ? UserAction::UP_BTN : UserAction::DOWN_BTN;
+      const bool behind = (dx < 0) != (data.direction == Direction::LEFT);
+      if (!behind) return UserAction::NO_ACT;
+      return head.y_ > 0 ? UserAction::UP_BTN : UserAction::DOWN_BTN;
+    }
+    if (dx != 0) return dx < 0 ? UserAction::LEFT_BTN : UserAction::RIGHT_BTN;
+    const bool behind = (dy < 0) != (data.direction == Direction::UP);
+    if (!behind) return UserAction::NO_ACT;
+    return head.x_ > 0 ? UserAction::LEFT_BTN : UserAction::RIGHT_BTN;
+  };
+}
+
+}  // namespace s21
+
+#endif  // BRICKGAME_SELFPLAY_SELF_PLAY_POLICIES_H_
@@ -0,0 +1,169 @@
+#ifndef BRICKGAME_SELFPLAY_SELF_PLAY_RUNNER_H_
+#define BRICKGAME_SELFPLAY_SELF_PLAY_RUNNER_H_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../base/BaseConstants.h"
+#include "../base/Clock.h"
+#include "../base/Random.h"
+#include "SelfPlayStats.h"
+#include "WorkStealingPool.h"
+
+namespace s21 {
+
+/**
+ * @brief Settings of a batch of self-played games.
+ */
+struct SelfPlayConfig {
+  size_t games = 1;           ///< Number of games to play
+  size_t threads = 0;         ///< Worker threads, 0 for one per core
+  std::uint64_t seed = 0;     ///< Seed of game 0, game i uses seed + i
+  size_t max_steps = 100000;  ///< Ticks after which a game is stopped
+  int width = ConstSizes::field_width;    ///< Columns of the field
+  int height = ConstSizes::field_height;  ///< Rows of the field
+};
+
+/**
+ * @brief Plays batches of games without a view on a work-stealing pool.
+ *
+ * Every worker thread owns one model on its own virtual clock, so games run
+ * as fast as the model can update and never share state. A policy chooses
+ * the action of every tick from the game data and a random sequence seeded
+ * from the game, which makes every game, and so the whole batch, depend on
+ * the seeds only and not on the number of threads. The actions reach the
+ * model through an input queue, as the actions of a view do.
+ *
+ * @tparam Model The model to play, SnakeModel or TetrisModel.
+ */
+template <typename Model>
+class SelfPlayRunner {
+ public:
+  /// @brief The game data of the model.
+  using GameData = typename Model::GameData;
+
+  /// @brief Chooses the action of the next tick.
+  using Policy = std::function<UserAction(const GameData&, Random&)>;
+
+  /**
+   * @brief Constructs a runner.
+   *
+   * @param config The settings of the batches.
+   * @param policy The policy playing every game, copied to every worker.
+   */
+  SelfPlayRunner(const SelfPlayConfig& config, Policy policy)
+      : config_(config),
+        policy_(std::move(policy)),
+        pool_(config.threads),
+        players_(pool_.size()) {}
+
+  /**
+   * @brief Gets the number of worker threads.
+   *
+   * @return The number of workers.
+   */
+  size_t threads() const { return pool_.size(); }
+
+  /**
+   * @brief Plays every game of the batch and aggregates the results.
+   *
+   * @return The statistics of the batch.
+   */
+  SelfPlayStats run() {
+    std::vector<GameResult> results(config_.games);
+    const auto start = std::chrono::steady_clock::now();
+    pool_.run(config_.games, [this, &results](size_t game, size_t worker) {
+      /* created by its own thread, so the model memory is local to it */
+      if (!players_[worker]) {
+        players_[worker].reset(new Player(config_, policy_));
+      }
+      results[game] = play(*players_[worker], game);
+    });
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    SelfPlayStats stats = summarizeGames(std::move(results), elapsed.count());
+    stats.stolen = pool_.getStolen();
+    return stats;
+  }
+
+ private:
+  /**
+   * @brief State of one worker, on cache lines of its own.
+   */
+  struct alignas(ConstSizes::cache_line_size) Player {
+    VirtualClock clock;  ///< Time of the model
+    Model model;         ///< The model played by the worker
+    Policy policy;       ///< Own copy of the policy
+    Random rng;          ///< Random sequence of the policy
+    InputQueue input;    ///< Actions of the policy for the next tick
+
+    Player(const SelfPlayConfig& config, const Policy& policy)
+        : model(config.width, config.height), policy(policy) {
+      model.setScoreSaving(false);
+      model.setClock(&clock);
+    }
+  };
+
+  SelfPlayConfig config_;                         ///< Settings of the batches
+  Policy policy_;                                 ///< Policy to copy
+  WorkStealingPool pool_;                         ///< Threads playing games
+  std::vector<std::unique_ptr<Player>> players_;  ///< One per worker
+
+  template <typename Data, typename = void>
+  struct HasLines : std::false_type {};
+  template <typename Data>
+  struct HasLines<Data, std::void_t<decltype(Data::lines)>>
+      : std::true_type {};
+
+  template <typename Data, typename = void>
+  struct HasWin : std::false_type {};
+  template <typename Data>
+  struct HasWin<Data, std::void_t<decltype(Data::win)>> : std::true_type {};
+
+  /**
+   * @brief Plays one game from the start screen to game over or the limit.
+   *
+   * @param player The worker playing the game.
+   * @param game The index of the game.
+   * @return The result of the game.
+   */
+  GameResult play(Player& player, size_t game) const {
+    GameResult result;
+    result.seed = config_.seed + game;
+
+    Model& model = player.model;
+    player.clock.set(0);
+    player.rng.seed(~result.seed);
+    model.setSeed(result.seed);
+    model.setDefault();
+    model.updateData(UserAction::SPACE_BTN);
+
+    const GameData& data = model.getModelData();
+    while (result.steps < config_.max_steps && !isOver(data.game_state)) {
+      player.clock.advance(ConstSizes::tick_ms);
+      player.input.push({player.policy(data, player.rng), player.clock.now()});
+      model.applyInput(player.input);
+      ++result.steps;
+    }
+
+    result.score = data.cur_score;
+    result.level = data.lvl;
+    result.finished = isOver(data.game_state);
+    if constexpr (HasLines<GameData>::value) result.lines = data.lines;
+    if constexpr (HasWin<GameData>::value) result.win = data.win;
+    return result;
+  }
+
+  static bool isOver(GameState state) {
+    return state == GameState::GAMEOVER || state == GameState::EXIT;
+  }
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_SELFPLAY_SELF_PLAY_RUNNER_H_
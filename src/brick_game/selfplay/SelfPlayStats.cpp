@@ -0,0 +1,45 @@
+#include "SelfPlayStats.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace s21 {
+
+SelfPlayStats summarizeGames(std::vector<GameResult> games, double seconds) {
+  SelfPlayStats stats;
+  stats.games = std::move(games);
+  stats.seconds = seconds;
+  if (stats.games.empty()) return stats;
+
+  std::vector<size_t> scores;
+  scores.reserve(stats.games.size());
+  size_t lines = 0;
+  for (const auto& game : stats.games) {
+    scores.push_back(game.score);
+    stats.steps += game.steps;
+    lines += game.lines;
+    if (game.level >= stats.levels.size()) stats.levels.resize(game.level + 1);
+    ++stats.levels[game.level];
+    stats.finished += game.finished;
+    stats.wins += game.win;
+  }
+
+  const double count = static_cast<double>(stats.games.size());
+  std::sort(scores.begin(), scores.end());
+  stats.min_score = scores.front();
+  stats.median_score = scores[scores.size() / 2];
+  stats.p90_score = scores[scores.size() * 9 / 10];
+  stats.max_score = scores.back();
+  double total = 0;
+  for (size_t score : scores) total += static_cast<double>(score);
+  stats.mean_score = total / count;
+  stats.mean_lines = static_cast<double>(lines) / count;
+
+  if (seconds > 0) {
+    stats.games_per_second = count / seconds;
+    stats.steps_per_second = static_cast<double>(stats.steps) / seconds;
+  }
+  return stats;
+}
+
+}  // namespace s21
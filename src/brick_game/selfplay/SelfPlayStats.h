@@ -0,0 +1,67 @@
+#ifndef BRICKGAME_SELFPLAY_SELF_PLAY_STATS_H_
+#define BRICKGAME_SELFPLAY_SELF_PLAY_STATS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @brief Outcome of one self-played game.
+ */
+struct GameResult {
+  std::uint64_t seed{};  ///< Seed the game was played with
+  size_t score{};        ///< Final score
+  size_t lines{};        ///< Cleared lines, 0 for games without lines
+  size_t level{};        ///< Level reached
+  size_t steps{};        ///< Ticks played
+  bool finished{};       ///< Game over was reached before the step limit
+  bool win{};            ///< The game was won
+
+  bool operator==(const GameResult& other) const {
+    return seed == other.seed && score == other.score &&
+           lines == other.lines && level == other.level &&
+           steps == other.steps && finished == other.finished &&
+           win == other.win;
+  }
+
+  bool operator!=(const GameResult& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Results of a batch of self-played games.
+ */
+struct SelfPlayStats {
+  std::vector<GameResult> games;  ///< Result of every game, by game index
+
+  size_t steps{};             ///< Ticks played by all games
+  double seconds{};           ///< Wall time of the batch
+  double games_per_second{};  ///< Games finished per second of wall time
+  double steps_per_second{};  ///< Ticks played per second of wall time
+
+  double mean_score{};    ///< Mean final score
+  size_t min_score{};     ///< Lowest final score
+  size_t median_score{};  ///< Median final score
+  size_t p90_score{};     ///< Score reached or beaten by 10% of the games
+  size_t max_score{};     ///< Highest final score
+
+  double mean_lines{};         ///< Mean number of cleared lines
+  std::vector<size_t> levels;  ///< Number of games ending on each level
+  size_t finished{};           ///< Games that reached game over
+  size_t wins{};               ///< Games that were won
+  size_t stolen{};             ///< Games moved between threads by stealing
+};
+
+/**
+ * @brief Aggregates the results of a batch of games.
+ *
+ * @param games The result of every game, by game index.
+ * @param seconds The wall time the batch took.
+ * @return The statistics of the batch.
+ */
+SelfPlayStats summarizeGames(std::vector<GameResult> games, double seconds);
+
+}  // namespace s21
+
+#endif  // BRICKGAME_SELFPLAY_SELF_PLAY_STATS_H_
@@ -0,0 +1,79 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+WorkStealingPool::WorkStealingPool(size_t threads)
+    : size_(threads ? threads
+                    : std::max(1u, std::thread::hardware_concurrency())),
+      workers_(new Worker[size_]) {}
+
+void WorkStealingPool::run(size_t count, const Task& task) {
+  for (size_t i = 0; i < size_; ++i) {
+    workers_[i].begin = count * i / size_;
+    workers_[i].end = count * (i + 1) / size_;
+    workers_[i].stolen = 0;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(size_ - 1);
+  for (size_t i = 1; i < size_; ++i) {
+    threads.emplace_back(&WorkStealingPool::work, this, i, std::cref(task));
+  }
+  work(0, task);
+  for (auto& thread : threads) thread.join();
+}
+
+size_t WorkStealingPool::getStolen() const {
+  size_t stolen = 0;
+  for (size_t i = 0; i < size_; ++i) stolen += workers_[i].stolen;
+  return stolen;
+}
+
+void WorkStealingPool::work(size_t id, const Task& task) {
+  size_t next = 0;
+  for (;;) {
+    if (pop(id, next)) {
+      task(next, id);
+    } else if (!steal(id)) {
+      break;
+    }
+  }
+}
+
+bool WorkStealingPool::pop(size_t id, size_t& next) {
+  Worker& self = workers_[id];
+  std::lock_guard<std::mutex> lock(self.mutex);
+  if (self.begin == self.end) return false;
+  next = self.begin++;
+  return true;
+}
+
+bool WorkStealingPool::steal(size_t id) {
+  for (size_t i = 1; i < size_; ++i) {
+    Worker& victim = workers_[(id + i) % size_];
+    size_t begin = 0;
+    size_t end = 0;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      const size_t left = victim.end - victim.begin;
+      if (left == 0) continue;
+      /* the victim keeps the front half, it is already working from there */
+      begin = victim.end - (left + 1) / 2;
+      end = victim.end;
+      victim.end = begin;
+    }
+    Worker& self = workers_[id];
+    std::lock_guard<std::mutex> lock(self.mutex);
+    self.begin = begin;
+    self.end = end;
+    self.stolen += end - begin;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace s21
@@ -0,0 +1,100 @@
+#ifndef BRICKGAME_SELFPLAY_WORK_STEALING_POOL_H_
+#define BRICKGAME_SELFPLAY_WORK_STEALING_POOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "../base/BaseConstants.h"
+
+namespace s21 {
+
+/**
+ * @brief Runs a batch of independent tasks on a fixed number of threads.
+ *
+ * The tasks of a batch are split into contiguous ranges, one per worker. A
+ * worker takes tasks from the front of its own range, and once it runs dry
+ * it steals the back half of the range of another worker, so long and short
+ * tasks even out without a shared queue. Every worker lives on its own cache
+ * line, so workers only share memory while stealing.
+ */
+class WorkStealingPool {
+ public:
+  /// @brief A task, called with the task index and the worker index.
+  using Task = std::function<void(size_t task, size_t worker)>;
+
+  /**
+   * @brief Constructs a pool.
+   *
+   * @param threads The number of worker threads, 0 for one per hardware
+   * thread.
+   */
+  explicit WorkStealingPool(size_t threads = 0);
+
+  /**
+   * @brief Gets the number of worker threads.
+   *
+   * @return The number of workers, at least one.
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * @brief Runs a task for every index of [0, count) and waits for all of
+   * them. The calling thread works as worker 0.
+   *
+   * @param count The number of tasks.
+   * @param task The task to run, called concurrently from every worker.
+   */
+  void run(size_t count, const Task& task);
+
+  /**
+   * @brief Gets the number of tasks taken from other workers by the last run.
+   *
+   * @return The number of stolen tasks.
+   */
+  size_t getStolen() const;
+
+ private:
+  /**
+   * @brief Range of tasks owned by a worker.
+   */
+  struct alignas(ConstSizes::cache_line_size) Worker {
+    std::mutex mutex;  ///< Guards the range
+    size_t begin{};    ///< First task left in the range
+    size_t end{};      ///< One past the last task of the range
+    size_t stolen{};   ///< Tasks this worker took from others
+  };
+
+  size_t size_;                        ///< Number of workers
+  std::unique_ptr<Worker[]> workers_;  ///< One range per worker
+
+  /**
+   * @brief Runs tasks on a worker until no worker has any left.
+   *
+   * @param id The index of the worker.
+   * @param task The task to run.
+   */
+  void work(size_t id, const Task& task);
+
+  /**
+   * @brief Takes the next task of a worker's own range.
+   *
+   * @param id The index of the worker.
+   * @param next The task taken.
+   * @return true if a task was taken; false if the range is empty.
+   */
+  bool pop(size_t id, size_t& next);
+
+  /**
+   * @brief Moves the back half of another worker's range to a worker.
+   *
+   * @param id The index of the stealing worker, whose range is empty.
+   * @return true if some tasks were stolen; false if every range is empty.
+   */
+  bool steal(size_t id);
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_SELFPLAY_WORK_STEALING_POOL_H_
@@ -0,0 +1,21 @@
+#include "OccupancyGrid.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+void OccupancyGrid::reset(int width, int height) {
+  width_ = width;
+  height_ = height;
+  stride_ = width + 2;
+  cells_.assign(static_cast<size_t>(stride_) * (height + 2), Cell::WALL);
+  slot_.assign(cells_.size(), -1);
+  free_.clear();
+  free_.reserve(static_cast<size_t>(width) * height);
+  for (int y = 0; y < height; ++y) {
+    std::fill_n(cells_.begin() + index(0, y), width, Cell::EMPTY);
+    for (int x = 0; x < width; ++x) addFree(index(x, y));
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,137 @@
+#ifndef BRICKGAME_SNAKE_OCCUPANCY_GRID_H_
+#define BRICKGAME_SNAKE_OCCUPANCY_GRID_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "../base/BaseConstants.h"
+
+namespace s21 {
+
+/**
+ * @brief Per-cell occupancy of the snake field.
+ *
+ * The field is stored row by row in one flat array surrounded by a one-cell
+ * border of walls, so any cell one step outside the field can be looked up
+ * without a bounds check. Self-collision, wall hits and fruit detection are
+ * therefore a single read, and the same array can back pathfinding.
+ *
+ * The empty cells are also kept in an indexable set. A cell is swap-removed
+ * from it when it gets filled and appended when it gets emptied, so a
+ * uniformly random empty cell is drawn in constant time.
+ */
+class OccupancyGrid {
+ public:
+  /// @brief Content of a cell. FRUIT and BODY match the snake color indices.
+  enum class Cell : std::uint8_t { EMPTY, FRUIT, BODY, WALL };
+
+  /**
+   * @brief Resizes the grid and empties every field cell.
+   *
+   * @param width The number of columns of the field.
+   * @param height The number of rows of the field.
+   */
+  void reset(int width, int height);
+
+  /**
+   * @brief Gets the content of a cell.
+   *
+   * @param x The column of the cell, from -1 to the width.
+   * @param y The row of the cell, from -1 to the height.
+   * @return The content of the cell, WALL on the border.
+   */
+  Cell get(int x, int y) const { return cells_[index(x, y)]; }
+
+  /**
+   * @brief Sets the content of a cell.
+   *
+   * @param x The column of the cell, from -1 to the width.
+   * @param y The row of the cell, from -1 to the height.
+   * @param cell The new content of the cell.
+   */
+  void set(int x, int y, Cell cell) {
+    const int i = index(x, y);
+    if (cells_[i] == Cell::EMPTY && cell != Cell::EMPTY) {
+      removeFree(i);
+    } else if (cells_[i] != Cell::EMPTY && cell == Cell::EMPTY) {
+      addFree(i);
+    }
+    cells_[i] = cell;
+  }
+
+  /**
+   * @brief Checks whether a cell can be entered.
+   *
+   * @param x The column of the cell, from -1 to the width.
+   * @param y The row of the cell, from -1 to the height.
+   * @return true if the cell is empty or holds the fruit; false otherwise.
+   */
+  bool isFree(int x, int y) const {
+    const Cell cell = get(x, y);
+    return cell == Cell::EMPTY || cell == Cell::FRUIT;
+  }
+
+  /**
+   * @brief Gets the flat index of a cell.
+   *
+   * Neighbours of a cell are at index +-1 and +-stride().
+   *
+   * @param x The column of the cell, from -1 to the width.
+   * @param y The row of the cell, from -1 to the height.
+   * @return The position of the cell in the flat array.
+   */
+  int index(int x, int y) const { return (y + 1) * stride_ + x + 1; }
+
+  /**
+   * @brief Gets the distance between two vertically adjacent cells.
+   *
+   * @return The number of cells in a padded row.
+   */
+  int stride() const { return stride_; }
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+
+  /**
+   * @brief Gets the number of empty cells.
+   *
+   * @return The number of empty field cells, 0 when the field is full.
+   */
+  int freeCount() const { return static_cast<int>(free_.size()); }
+
+  /**
+   * @brief Draws a uniformly random empty cell.
+   *
+   * @param rng The generator to draw from.
+   * @return The coordinates of the cell. The grid must have an empty cell.
+   */
+  Cords randomFree(Random& rng) const {
+    const int i = free_[rng.uniform(0, freeCount() - 1)];
+    return Cords(i % stride_ - 1, i / stride_ - 1);
+  }
+
+ private:
+  std::vector<Cell> cells_;  ///< Padded cells, row by row
+  std::vector<int> free_;    ///< Flat indices of the empty cells
+  std::vector<int> slot_;    ///< Position of each cell in free_, -1 if filled
+  int width_{};              ///< Number of field columns
+  int height_{};             ///< Number of field rows
+  int stride_{};             ///< Number of columns including the border
+
+  void addFree(int i) {
+    slot_[i] = static_cast<int>(free_.size());
+    free_.push_back(i);
+  }
+
+  void removeFree(int i) {
+    const int last = free_.back();
+    free_[slot_[i]] = last;
+    slot_[last] = slot_[i];
+    slot_[i] = -1;
+    free_.pop_back();
+  }
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_SNAKE_OCCUPANCY_GRID_H_
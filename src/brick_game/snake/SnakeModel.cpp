@@ -2,203 +2,263 @@
 
 namespace s21 {
 
-SnakeModel::SnakeModel() : snake_data_() {
-  initEventHandlersMatrix();
+using Cell = OccupancyGrid::Cell;
+
+SnakeModel::SnakeModel(int width, int height) : snake_data_() {
+  initChangeLog(fitFieldSize(width), fitFieldSize(height));
+  occupancy_.reset(getFieldWidth(), getFieldHeight());
+  snake_data_.snake_coord.reserve(static_cast<size_t>(getFieldWidth()) *
+                                  getFieldHeight());
   snake_data_.best_score = readBestScore("SnakeScore.txt");
 };
 
 SnakeModel::~SnakeModel() {
-  writeBestScore(snake_data_.best_score, "SnakeScore.txt");
-  snake_data_.snake_coord.clear();
+  if (isScoreSaving()) writeBestScore(snake_data_.best_score, "SnakeScore.txt");
 };
 
-void SnakeModel::initEventHandlersMatrix() {
+constexpr StateActionMatrix<SnakeModel>
+SnakeModel::makeEventHandlersMatrix() {
+  StateActionMatrix<SnakeModel> matrix;
+
   /* START STATE */
-  EventsMatrix[GameState::START][UserAction::SPACE_BTN] = &SnakeModel::Start;
-  EventsMatrix[GameState::START][UserAction::ENTER_BTN] = &SnakeModel::Start;
-  EventsMatrix[GameState::START][UserAction::ESC_BTN] = &SnakeModel::ExitGame;
+  matrix[GameState::START][UserAction::SPACE_BTN] = &SnakeModel::Start;
+  matrix[GameState::START][UserAction::ENTER_BTN] = &SnakeModel::Start;
+  matrix[GameState::START][UserAction::ESC_BTN] = &SnakeModel::ExitGame;
 
   /* |SPAWN|COLLIDE|EXIT|GAMEOVER| STATES */
   for (int i = 0; i < USER_ACTIONS_CNT; i++) {
-    EventsMatrix[GameState::SPAWN][static_cast<UserAction>(i)] =
-        &SnakeModel::Spawn;
+    matrix[GameState::SPAWN][static_cast<UserAction>(i)] = &SnakeModel::Spawn;
 
-    EventsMatrix[GameState::COLLIDE][static_cast<UserAction>(i)] =
+    matrix[GameState::COLLIDE][static_cast<UserAction>(i)] =
         &SnakeModel::Collide;
 
-    EventsMatrix[GameState::EXIT][static_cast<UserAction>(i)] =
-        &SnakeModel::ExitGame;
+    matrix[GameState::EXIT][static_cast<UserAction>(i)] = &SnakeModel::ExitGame;
 
-    EventsMatrix[GameState::GAMEOVER][static_cast<UserAction>(i)] =
+    matrix[GameState::GAMEOVER][static_cast<UserAction>(i)] =
         &SnakeModel::GameOver;
   }
 
   /* MOVING STATE */
-  EventsMatrix[GameState::MOVING][UserAction::UP_BTN] = &SnakeModel::MoveHeadUp;
-  EventsMatrix[GameState::MOVING][UserAction::DOWN_BTN] =
-      &SnakeModel::MoveHeadDown;
-  EventsMatrix[GameState::MOVING][UserAction::RIGHT_BTN] =
-      &SnakeModel::MoveHeadRight;
-  EventsMatrix[GameState::MOVING][UserAction::LEFT_BTN] =
-      &SnakeModel::MoveHeadLeft;
-  EventsMatrix[GameState::MOVING][UserAction::SPACE_BTN] = &SnakeModel::Pause;
-  EventsMatrix[GameState::MOVING][UserAction::TAB_BTN] = &SnakeModel::Pause;
-  EventsMatrix[GameState::MOVING][UserAction::ESC_BTN] = &SnakeModel::ExitGame;
+  matrix[GameState::MOVING][UserAction::UP_BTN] = &SnakeModel::MoveHeadUp;
+  matrix[GameState::MOVING][UserAction::DOWN_BTN] = &SnakeModel::MoveHeadDown;
+  matrix[GameState::MOVING][UserAction::RIGHT_BTN] = &SnakeModel::MoveHeadRight;
+  matrix[GameState::MOVING][UserAction::LEFT_BTN] = &SnakeModel::MoveHeadLeft;
+  matrix[GameState::MOVING][UserAction::SPACE_BTN] = &SnakeModel::Pause;
+  matrix[GameState::MOVING][UserAction::TAB_BTN] = &SnakeModel::Pause;
+  matrix[GameState::MOVING][UserAction::ESC_BTN] = &SnakeModel::ExitGame;
 
   /* PAUSE STATE */
-  EventsMatrix[GameState::PAUSE][UserAction::ENTER_BTN] = &SnakeModel::Unpause;
-  EventsMatrix[GameState::PAUSE][UserAction::TAB_BTN] = &SnakeModel::Unpause;
-  EventsMatrix[GameState::PAUSE][UserAction::ESC_BTN] = &SnakeModel::ExitGame;
+  matrix[GameState::PAUSE][UserAction::ENTER_BTN] = &SnakeModel::Unpause;
+  matrix[GameState::PAUSE][UserAction::TAB_BTN] = &SnakeModel::Unpause;
+  matrix[GameState::PAUSE][UserAction::ESC_BTN] = &SnakeModel::ExitGame;
+
+  return matrix;
 }
 
-SnakeModel::GameData& SnakeModel::getModelData() { return snake_data_; };
+constexpr StateActionMatrix<SnakeModel> SnakeModel::EventsMatrix =
+    SnakeModel::makeEventHandlersMatrix();
 
-void SnakeModel::updateData(UserAction action) {
-  snake_data_.was_modified = false;
-  GameData tmp = snake_data_;
+SnakeModel::GameData& SnakeModel::getModelData() { return snake_data_; };
 
-  cur_time_ = last_move_time_;
-  if (snake_data_.game_state != GameState::PAUSE) cur_time_ = getCurTime();
+void SnakeModel::updateData(UserAction action) { update<false>(action); }
 
-  using Action = void (SnakeModel::*)();
-  Action cur_func = EventsMatrix[snake_data_.game_state][action];
+template <bool kRuntimeDispatch>
+void SnakeModel::update(UserAction action) {
+  const Version version = getVersion();
 
-  if (cur_func) (this->*cur_func)();
+  cur_time_ = getCurTime();
 
-  if (snake_data_.game_state == GameState::MOVING) {
-    if (cur_time_ - last_move_time_ >= cur_interval_) moveSnake();
+  using Dispatcher = StateActionDispatcher<SnakeModel, EventsMatrix>;
+  if constexpr (kRuntimeDispatch) {
+    Dispatcher::dispatchRuntime(this, snake_data_.game_state, action);
+  } else {
+    Dispatcher::dispatch(this, snake_data_.game_state, action);
   }
 
-  if (snake_data_ != tmp) snake_data_.was_modified = true;
+  runTimedSteps(cur_time_);
+
+  snake_data_.was_modified = getVersion() != version;
+}
+
+void SnakeModel::runTimedSteps(long long time) {
+  if (snake_data_.game_state != GameState::MOVING) return;
+
+  /* every elapsed interval is a move, the rest of the time carries over */
+  move_timer_.limitBacklog(time);
+  while (snake_data_.game_state == GameState::MOVING &&
+         move_timer_.step(time)) {
+    moveSnake();
+  }
 }
 
+/* the benchmarks call both dispatches */
+template void SnakeModel::update<false>(UserAction action);
+template void SnakeModel::update<true>(UserAction action);
+
 void SnakeModel::setDefault() {
-  cur_interval_ = ConstSizes::levels_intervals_ms[0];
   cur_time_ = getCurTime();
-  last_move_time_ = cur_time_;
+  move_timer_.restart(cur_time_);
+  move_timer_.setInterval(ConstSizes::levels_intervals_ms[0]);
   snake_data_.cur_score = 0;
+  snake_data_.win = false;
   snake_data_.lvl = 1;
   snake_data_.direction = Direction::UP;
-  snake_data_.game_state = GameState::START;
+  setState(GameState::START);
   snake_data_.snake_coord.clear();
-  snake_data_.snake_coord.reserve(200);
+  occupancy_.reset(getFieldWidth(), getFieldHeight());
 
-  snake_data_.snake_coord.push_back({5, ConstSizes::field_height / 2});
-  snake_data_.snake_coord.push_back({5, ConstSizes::field_height / 2 + 1});
-  snake_data_.snake_coord.push_back({5, ConstSizes::field_height / 2 + 2});
-  snake_data_.snake_coord.push_back({5, ConstSizes::field_height / 2 + 3});
+  for (int i = 0; i < 4; ++i) {
+    const Cords segment(getFieldWidth() / 2, getFieldHeight() / 2 + i);
+    snake_data_.snake_coord.push_back(segment);
+    occupancy_.set(segment.x_, segment.y_, Cell::BODY);
+  }
 
   updateFruitPos();
+  touchAll();
+  markAll();
 }
 
-void SnakeModel::updateFruitPos() {
-  snake_data_.fruit_coord.randomCords();
-  for (const auto& i : snake_data_.snake_coord) {
-    if (snake_data_.fruit_coord == i) {
-      updateFruitPos();
-    }
+bool SnakeModel::updateFruitPos() {
+  setFruit(kNoFruit);
+  if (occupancy_.freeCount() == 0) return false;
+  setFruit(occupancy_.randomFree(rng_));
+  return true;
+}
+
+void SnakeModel::setFruit(const Cords& cell) {
+  Cords& fruit = snake_data_.fruit_coord;
+  if (isInField(fruit) && occupancy_.get(fruit.x_, fruit.y_) == Cell::FRUIT) {
+    occupancy_.set(fruit.x_, fruit.y_, Cell::EMPTY);
+  }
+  markCell(fruit.x_, fruit.y_);
+  fruit = cell;
+  if (isInField(fruit) && occupancy_.get(fruit.x_, fruit.y_) == Cell::EMPTY) {
+    occupancy_.set(fruit.x_, fruit.y_, Cell::FRUIT);
   }
+  markCell(fruit.x_, fruit.y_);
+}
+
+bool SnakeModel::isInField(const Cords& cell) const {
+  return cell.x_ >= 0 && cell.y_ >= 0 && cell.x_ < getFieldWidth() &&
+         cell.y_ < getFieldHeight();
 }
 
 void SnakeModel::updateScores() {
   snake_data_.cur_score++;
+  touch(ModelComponent::HUD);
+  markHud(HudItem::SCORE);
 
   if (snake_data_.cur_score > snake_data_.best_score) {
     snake_data_.best_score = snake_data_.cur_score;
+    markHud(HudItem::BEST_SCORE);
   }
   if (snake_data_.cur_score % 5 == 0 && snake_data_.lvl < 10) {
     snake_data_.lvl++;
-    cur_interval_ = ConstSizes::levels_intervals_ms[snake_data_.lvl - 1];
+    markHud(HudItem::LEVEL);
+    move_timer_.setInterval(
+        ConstSizes::levels_intervals_ms[snake_data_.lvl - 1]);
   }
+}
 
-  if (snake_data_.cur_score == 200) {
-    snake_data_.win = 1;
-    snake_data_.game_state = GameState::GAMEOVER;
+const OccupancyGrid& SnakeModel::getOccupancy() const { return occupancy_; }
+
+long long SnakeModel::getNextDeadline() const {
+  switch (snake_data_.game_state) {
+    case GameState::MOVING:
+      return move_timer_.getDeadline();
+    case GameState::SPAWN:
+    case GameState::COLLIDE:
+      return getCurTime();
+    default:
+      return kNoDeadline;
   }
 }
 
-void SnakeModel::checkEating() {
-  if (snake_data_.snake_coord[0] == snake_data_.fruit_coord) {
-    snake_data_.snake_coord.push_back(snake_data_.snake_coord.back());
-    updateScores();
-    updateFruitPos();
+int SnakeModel::getCellColor(int x, int y) const {
+  switch (occupancy_.get(x, y)) {
+    case Cell::FRUIT:
+      return kFruitColor;
+    case Cell::BODY:
+      return kBodyColor;
+    default:
+      return 0;
   }
 }
 
-void SnakeModel::checkCollision() {
-  for (size_t i = 1; i < snake_data_.snake_coord.size(); ++i) {
-    if (snake_data_.snake_coord[0] == snake_data_.snake_coord[i]) {
-      snake_data_.game_state = GameState::COLLIDE;
+void SnakeModel::checkEating() {
+  if (snake_data_.snake_coord.front() == snake_data_.fruit_coord) {
+    updateScores();
+    if (!updateFruitPos()) {
+      snake_data_.win = 1;
+      setState(GameState::GAMEOVER);
     }
   }
-  if (snake_data_.snake_coord[0].x_ < 0 ||
-      snake_data_.snake_coord[0].x_ >= ConstSizes::field_width) {
-    snake_data_.game_state = GameState::COLLIDE;
-  }
-
-  if (snake_data_.snake_coord[0].y_ < 0 ||
-      snake_data_.snake_coord[0].y_ >= ConstSizes::field_height) {
-    snake_data_.game_state = GameState::COLLIDE;
-  }
 }
 
-void SnakeModel::moveSnake() {
-  switch (snake_data_.direction) {
-    case Direction::UP:
-      MoveHeadUp();
-      break;
-    case Direction::DOWN:
-      MoveHeadDown();
-      break;
-    case Direction::RIGHT:
-      MoveHeadRight();
-      break;
-    case Direction::LEFT:
-      MoveHeadLeft();
-      break;
+void SnakeModel::checkCollision(Cell entered) {
+  if (entered == Cell::BODY || entered == Cell::WALL) {
+    setState(GameState::COLLIDE);
   }
 }
 
-void SnakeModel::MoveBody() {
-  for (auto i = snake_data_.snake_coord.size(); i > 0; --i) {
-    snake_data_.snake_coord[i] = snake_data_.snake_coord[i - 1];
+void SnakeModel::moveSnake() { MoveHead(snake_data_.direction); }
+
+Cell SnakeModel::MoveBody(const Cords& head) {
+  auto& body = snake_data_.snake_coord;
+  /* the tail stays in place on the move that eats the fruit */
+  if (head != snake_data_.fruit_coord) {
+    occupancy_.set(body.back().x_, body.back().y_, Cell::EMPTY);
+    markCell(body.back().x_, body.back().y_);
+    body.pop_back();
   }
+  /* the tail leaves before the head enters, so following it is allowed */
+  const Cell entered = occupancy_.get(head.x_, head.y_);
+  body.push_front(head);
+  if (entered != Cell::WALL) occupancy_.set(head.x_, head.y_, Cell::BODY);
+  markCell(head.x_, head.y_);
+  return entered;
 }
 
-void SnakeModel::MoveHead(Direction direction) {
-  if (IsOppositeDirection(direction)) return;
+bool SnakeModel::MoveHead(Direction direction) {
+  if (IsOppositeDirection(direction)) return false;
   snake_data_.direction = direction;
-  MoveBody();
-  UpdateHeadPosition(direction);
+  const Cell entered = MoveBody(NextHeadPosition(direction));
+  touch(ModelComponent::FIELD);
   checkEating();
-  checkCollision();
-  last_move_time_ = cur_time_;
+  checkCollision(entered);
+  return true;
 }
 
-void SnakeModel::UpdateHeadPosition(Direction direction) {
+void SnakeModel::Steer(Direction direction) {
+  if (MoveHead(direction)) move_timer_.restart(cur_time_);
+}
+
+Cords SnakeModel::NextHeadPosition(Direction direction) const {
+  Cords head = snake_data_.snake_coord.front();
   switch (direction) {
     case Direction::UP:
-      snake_data_.snake_coord[0].y_ -= 1;
+      head.y_ -= 1;
       break;
     case Direction::DOWN:
-      snake_data_.snake_coord[0].y_ += 1;
+      head.y_ += 1;
       break;
     case Direction::LEFT:
-      snake_data_.snake_coord[0].x_ -= 1;
+      head.x_ -= 1;
       break;
     case Direction::RIGHT:
-      snake_data_.snake_coord[0].x_ += 1;
+      head.x_ += 1;
       break;
   }
+  return head;
 }
 
-void SnakeModel::MoveHeadUp() { MoveHead(Direction::UP); }
+void SnakeModel::MoveHeadUp() { Steer(Direction::UP); }
 
-void SnakeModel::MoveHeadDown() { MoveHead(Direction::DOWN); }
+void SnakeModel::MoveHeadDown() { Steer(Direction::DOWN); }
 
-void SnakeModel::MoveHeadLeft() { MoveHead(Direction::LEFT); }
+void SnakeModel::MoveHeadLeft() { Steer(Direction::LEFT); }
 
-void SnakeModel::MoveHeadRight() { MoveHead(Direction::RIGHT); }
+void SnakeModel::MoveHeadRight() { Steer(Direction::RIGHT); }
 
 bool SnakeModel::IsOppositeDirection(Direction new_direction) {
   return (snake_data_.direction == Direction::UP &&
@@ -211,18 +271,35 @@ bool SnakeModel::IsOppositeDirection(Direction new_direction) {
           new_direction == Direction::LEFT);
 }
 
-void SnakeModel::Start() { snake_data_.game_state = GameState::SPAWN; }
+void SnakeModel::setState(GameState state) {
+  if (snake_data_.game_state == state) return;
+  snake_data_.game_state = state;
+  touch(ModelComponent::STATE);
+}
 
-void SnakeModel::Spawn() { snake_data_.game_state = GameState::MOVING; }
+void SnakeModel::Start() { setState(GameState::SPAWN); }
 
-void SnakeModel::Pause() { snake_data_.game_state = GameState::PAUSE; }
+void SnakeModel::Spawn() { setState(GameState::MOVING); }
 
-void SnakeModel::Unpause() { snake_data_.game_state = GameState::MOVING; }
+void SnakeModel::Pause() {
+  move_timer_.pause(cur_time_);
+  setState(GameState::PAUSE);
+}
+
+void SnakeModel::Unpause() {
+  move_timer_.resume(cur_time_);
+  setState(GameState::MOVING);
+}
 
-void SnakeModel::GameOver() { snake_data_.game_state = GameState::GAMEOVER; }
+void SnakeModel::GameOver() { setState(GameState::GAMEOVER); }
 
-void SnakeModel::ExitGame() { snake_data_.game_state = GameState::EXIT; }
+void SnakeModel::ExitGame() { setState(GameState::EXIT); }
 
-void SnakeModel::Collide() { snake_data_.game_state = GameState::GAMEOVER; }
+void SnakeModel::Collide() { setState(GameState::GAMEOVER); }
+
+void SnakeModel::shiftTime(long long delta) {
+  cur_time_ += delta;
+  move_timer_.shift(delta);
+}
 
 }  // namespace s21
\ No newline at end of file
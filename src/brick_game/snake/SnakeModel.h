@@ -3,9 +3,11 @@
 
 #include <cstddef>
 #include <functional>
-#include <vector>
 
 #include "../base/BaseModel.h"
+#include "../base/FixedTimestep.h"
+#include "../base/RingBuffer.h"
+#include "OccupancyGrid.h"
 
 namespace s21 {
 
@@ -15,13 +17,22 @@ enum class Direction { UP, DOWN, LEFT, RIGHT };
 
 class SnakeModel : public BaseModel {
  public:
+  /// @brief Color index of the fruit cell.
+  static constexpr int kFruitColor = 1;
+
+  /// @brief Color index of the snake cells.
+  static constexpr int kBodyColor = 2;
+
+  /// @brief Fruit position meaning there is no fruit on the field.
+  static constexpr Cords kNoFruit = Cords(-1, -1);
+
   /**
    * @brief Structure to hold the game data including the snake's position,
    * fruit position, current score, etc.
    */
   struct GameData {
-    std::vector<Cords>
-        snake_coord;       ///< Coordinates of the snake's body segments
+    RingBuffer<Cords>
+        snake_coord;       ///< Coordinates of the snake's body, head first
     Cords fruit_coord;     ///< Coordinates of the fruit
     Direction direction;   ///< Current direction of the snake's movement
     GameState game_state;  ///< Current state of the game
@@ -70,7 +81,16 @@ class SnakeModel : public BaseModel {
     bool operator!=(const GameData& other) const { return !(*this == other); }
   };
 
-  SnakeModel();
+  /**
+   * @brief Constructs a new SnakeModel object.
+   *
+   * @param width The number of columns of the field, clamped to the
+   * supported range.
+   * @param height The number of rows of the field, clamped to the supported
+   * range.
+   */
+  explicit SnakeModel(int width = ConstSizes::field_width,
+                      int height = ConstSizes::field_height);
   ~SnakeModel();
 
   /**
@@ -78,12 +98,12 @@ class SnakeModel : public BaseModel {
    *
    * @param action The action performed by the user.
    */
-  void updateData(UserAction action);
+  void updateData(UserAction action) override;
 
   /**
    * @brief Resets the game data to its default values.
    */
-  void setDefault();
+  void setDefault() override;
 
   /**
    * @brief Returns the current game data.
@@ -92,17 +112,89 @@ class SnakeModel : public BaseModel {
    */
   GameData& getModelData();
 
+  /**
+   * @brief Gets the color of a field cell.
+   *
+   * @param x The column of the cell.
+   * @param y The row of the cell.
+   * @return The color index of the cell, 0 for an empty cell.
+   */
+  int getCellColor(int x, int y) const override;
+
+  /**
+   * @brief Gets the time of the next snake move, or of the next state change
+   * when the game moves on by itself.
+   *
+   * @return The time in milliseconds on the model clock, or kNoDeadline
+   * while the game waits for input.
+   */
+  long long getNextDeadline() const override;
+
+  /**
+   * @brief Gets the occupancy of the field, e.g. for pathfinding.
+   *
+   * @return The grid holding the snake, the fruit and the walls.
+   */
+  const OccupancyGrid& getOccupancy() const;
+
+  /**
+   * @brief Places the fruit on a cell, e.g. to script a scenario.
+   *
+   * @param cell An empty field cell, or kNoFruit to remove the fruit.
+   */
+  void setFruit(const Cords& cell);
+
+ protected:
+  /**
+   * @brief Moves the model timers onto a clock that reads differently.
+   *
+   * @param delta The offset in milliseconds.
+   */
+  void shiftTime(long long delta) override;
+
+  /**
+   * @brief Takes the snake moves due by a time.
+   *
+   * @param time The time in milliseconds on the model clock.
+   */
+  void runTimedSteps(long long time) override;
+
  private:
   GameData snake_data_;
-  StateActionMatrix<SnakeModel> EventsMatrix;
+  OccupancyGrid occupancy_;
   long long cur_time_{};
-  long long last_move_time_{};
-  long long cur_interval_{};
+  FixedTimestep move_timer_;
+
+  static const StateActionMatrix<SnakeModel> EventsMatrix;
+
+  /// The benchmarks call update() with either dispatch
+  friend struct DispatchAccess;
+
+  /**
+   * @brief Updates the game data, calling the handler of the current state
+   * through the compile-time dispatcher or through a lookup in EventsMatrix
+   * at run time. updateData() uses the dispatcher.
+   *
+   * @tparam kRuntimeDispatch Whether to look the handler up at run time.
+   * @param action The action performed by the user.
+   */
+  template <bool kRuntimeDispatch>
+  void update(UserAction action);
 
   /**
-   * @brief Updates the position of the fruit.
+   * @brief Moves the fruit to a random empty cell.
+   *
+   * @return true if the fruit was placed; false if the board is full.
+   */
+  bool updateFruitPos();
+
+  /**
+   * @brief Checks whether a cell lies on the field.
+   *
+   * @param cell The cell to check.
+   * @return true if the cell is on the field; false otherwise.
    */
-  void updateFruitPos();
+  bool isInField(const Cords& cell) const;
 
   /**
    * @brief Updates the scores in the game data.
@@ -118,15 +210,19 @@ class SnakeModel : public BaseModel {
   /**
    * @brief Checks for collisions and updates the game state if a collision is
    * detected.
+   *
+   * @param entered The content of the cell the head moved into.
    */
-  void checkCollision();
+  void checkCollision(OccupancyGrid::Cell entered);
 
   /* FSM */
 
   /**
-   * @brief Initializes the event handlers matrix.
+   * @brief Builds the event handlers matrix at compile time.
+   *
+   * @return The matrix mapping each state and action to its handler.
    */
-  void initEventHandlersMatrix();
+  static constexpr StateActionMatrix<SnakeModel> makeEventHandlersMatrix();
 
   /**
    * @brief Moves the snake in the current direction.
@@ -137,15 +233,26 @@ class SnakeModel : public BaseModel {
    * @brief Moves the snake's head in the specified direction.
    *
    * @param direction The direction in which to move the head.
+   * @return true if the snake moved; false if the direction is opposite to
+   * the current one.
+   */
+  bool MoveHead(Direction direction);
+
+  /**
+   * @brief Moves the snake on the player's command and starts the next
+   * timed move from now.
+   *
+   * @param direction The direction in which to move the head.
    */
-  void MoveHead(Direction direction);
+  void Steer(Direction direction);
 
   /**
-   * @brief Updates the position of the snake's head based on the direction.
+   * @brief Computes where the snake's head moves in a direction.
    *
-   * @param direction The direction in which to update the head position.
+   * @param direction The direction of the move.
+   * @return The new position of the head.
    */
-  void UpdateHeadPosition(Direction direction);
+  Cords NextHeadPosition(Direction direction) const;
 
   /**
    * @brief Checks if the new direction is opposite to the current direction.
@@ -157,8 +264,15 @@ class SnakeModel : public BaseModel {
 
   /**
    * @brief Moves the body of the snake to follow the head.
+   *
+   * Pushes the new head and pops the tail, unless the head reaches the fruit,
+   * in which case the snake grows by keeping its tail. The occupancy grid is
+   * updated as the tail leaves and the head enters.
+   *
+   * @param head The new position of the head.
+   * @return The content of the cell the head moved into.
    */
-  void MoveBody();
+  OccupancyGrid::Cell MoveBody(const Cords& head);
 
   /**
    * @brief Moves the head of the snake up.
@@ -182,6 +296,13 @@ class SnakeModel : public BaseModel {
 
   /* STATES UPDATE */
 
+  /**
+   * @brief Changes the game state and marks it as changed.
+   *
+   * @param state The new game state.
+   */
+  void setState(GameState state);
+
   /**
    * @brief Starts the game by initializing the game state.
    */
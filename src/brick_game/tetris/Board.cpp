@@ -0,0 +1,91 @@
+#include "Board.h"
+
+#include <algorithm>
+
+namespace s21 {
+
+Board::Board(int width, int height)
+    : width_(width),
+      height_(height),
+      words_((width + kWordBits - 1) / kWordBits),
+      last_full_(~RowMask{0} >> (words_ * kWordBits - width)),
+      rows_(static_cast<size_t>(words_) * height),
+      colors_(static_cast<size_t>(width) * height),
+      heights_(width) {
+  cleared_.reserve(height);
+}
+
+void Board::clear() {
+  std::fill(rows_.begin(), rows_.end(), 0);
+  std::fill(colors_.begin(), colors_.end(), 0);
+  std::fill(heights_.begin(), heights_.end(), 0);
+}
+
+bool Board::isRowEmpty(int row) const {
+  const RowMask *words = rowWords(row);
+  if (words_ == 1) return !words[0];
+  return std::all_of(words, words + words_, [](RowMask w) { return !w; });
+}
+
+bool Board::isRowFull(int row) const {
+  const RowMask *words = rowWords(row);
+  if (words_ == 1) return words[0] == last_full_;
+  return std::all_of(words, words + words_ - 1,
+                     [](RowMask w) { return w == ~RowMask{0}; }) &&
+         words[words_ - 1] == last_full_;
+}
+
+void Board::setCell(int row, int col, int color) {
+  rowWords(row)[col / kWordBits] |= RowMask{1} << (col % kWordBits);
+  colors_[static_cast<size_t>(row) * width_ + col] =
+      static_cast<std::uint8_t>(color);
+  heights_[col] = std::max(heights_[col], height_ - row);
+}
+
+void Board::resetCell(int row, int col) {
+  rowWords(row)[col / kWordBits] &= ~(RowMask{1} << (col % kWordBits));
+  colors_[static_cast<size_t>(row) * width_ + col] = 0;
+  if (row == getSurfaceRow(col)) updateHeight(col);
+}
+
+const Board::ClearedRows &Board::clearFullRows() {
+  cleared_.clear();
+  int dst = height_ - 1;
+  for (int src = height_ - 1; src >= 0; --src) {
+    if (isRowFull(src)) {
+      cleared_.push_back(src);
+      continue;
+    }
+    if (dst != src) {
+      std::copy_n(rowWords(src), words_, rowWords(dst));
+      std::copy_n(colors_.begin() + static_cast<size_t>(src) * width_, width_,
+                  colors_.begin() + static_cast<size_t>(dst) * width_);
+    }
+    --dst;
+  }
+  if (cleared_.empty()) return cleared_;
+
+  const int cnt = dst + 1;
+  std::fill_n(rows_.begin(), static_cast<size_t>(cnt) * words_, 0);
+  std::fill_n(colors_.begin(), static_cast<size_t>(cnt) * width_, 0);
+  /* full rows lie at or below every surface, so a column only drops by the
+   * cleared count unless its top cell was cleared too */
+  for (int col = 0; col < width_; ++col) {
+    const int surface = getSurfaceRow(col);
+    if (std::find(cleared_.begin(), cleared_.end(), surface) !=
+        cleared_.end()) {
+      updateHeight(col);
+    } else {
+      heights_[col] -= cnt;
+    }
+  }
+  return cleared_;
+}
+
+void Board::updateHeight(int col) {
+  int row = 0;
+  while (row < height_ && !isFilled(row, col)) ++row;
+  heights_[col] = height_ - row;
+}
+
+}  // namespace s21
@@ -0,0 +1,202 @@
+#ifndef BRICKGAME_TETRIS_BOARD_H_
+#define BRICKGAME_TETRIS_BOARD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../base/BaseConstants.h"
+
+namespace s21 {
+
+/**
+ * @brief Bitboard representation of the Tetris playfield.
+ *
+ * Occupancy is stored as 64-bit words, one or more per row (bit j of word w
+ * is column 64 * w + j), so line-full checks and collisions are word compares.
+ * Colors live in a separate byte plane that is only touched when a cell is
+ * written or rendered. Both are single flat buffers sized at construction,
+ * and a per-column height map describing the surface of the stack is kept up
+ * to date as cells are written and rows are cleared. Boards up to 64 columns
+ * wide, including the default 10x20 one, keep a whole row in a single word.
+ */
+class Board {
+ public:
+  /// @brief Occupancy mask of 64 columns of a row.
+  using RowMask = std::uint64_t;
+
+  /// @brief Height of every column, counted from the bottom of the board.
+  using Heights = std::vector<int>;
+
+  /// @brief Rows removed by a sweep, from the bottom up.
+  using ClearedRows = std::vector<int>;
+
+  /// @brief Number of columns held by one occupancy word.
+  static constexpr int kWordBits = 64;
+
+  /**
+   * @brief Constructs an empty board.
+   *
+   * @param width The number of columns.
+   * @param height The number of rows.
+   */
+  explicit Board(int width = ConstSizes::field_width,
+                 int height = ConstSizes::field_height);
+
+  /**
+   * @brief Empties every cell of the board.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the width of the board.
+   *
+   * @return The number of columns.
+   */
+  int width() const { return width_; }
+
+  /**
+   * @brief Gets the height of the board.
+   *
+   * @return The number of rows.
+   */
+  int height() const { return height_; }
+
+  /**
+   * @brief Checks whether a cell is occupied.
+   *
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @return true if the cell is occupied; false otherwise.
+   */
+  bool isFilled(int row, int col) const {
+    return (rowWords(row)[col / kWordBits] >> (col % kWordBits)) & 1u;
+  }
+
+  /**
+   * @brief Gets the color of a cell.
+   *
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @return The color index of the cell, 0 for an empty cell.
+   */
+  int getColor(int row, int col) const {
+    return colors_[static_cast<size_t>(row) * width_ + col];
+  }
+
+  /**
+   * @brief Gets one occupancy word of a row.
+   *
+   * @param row The row to read.
+   * @param word The word to read, 0 for the first 64 columns.
+   * @return The occupancy mask of those columns.
+   */
+  RowMask getRow(int row, int word = 0) const { return rowWords(row)[word]; }
+
+  /**
+   * @brief Checks whether a row has no occupied cell.
+   *
+   * @param row The row to check.
+   * @return true if the row is empty; false otherwise.
+   */
+  bool isRowEmpty(int row) const;
+
+  /**
+   * @brief Gets the height map of the board.
+   *
+   * @return The height of every column, 0 for an empty column.
+   */
+  const Heights& getHeights() const { return heights_; }
+
+  /**
+   * @brief Gets the topmost occupied row of a column.
+   *
+   * @param col The column to read.
+   * @return The row of the surface, height() for an empty column.
+   */
+  int getSurfaceRow(int col) const { return height_ - heights_[col]; }
+
+  /**
+   * @brief Checks whether every column of a row is occupied.
+   *
+   * @param row The row to check.
+   * @return true if the row is full; false otherwise.
+   */
+  bool isRowFull(int row) const;
+
+  /**
+   * @brief Occupies a cell with the given color.
+   *
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   * @param color The color index of the cell.
+   */
+  void setCell(int row, int col, int color);
+
+  /**
+   * @brief Empties a cell.
+   *
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   */
+  void resetCell(int row, int col);
+
+  /**
+   * @brief Removes every full row in a single bottom-up sweep.
+   *
+   * The remaining rows are compacted towards the bottom and the freed rows
+   * at the top are emptied, so any number of lines costs one pass.
+   *
+   * @return The removed rows from the bottom up, in coordinates before the
+   * sweep. The reference stays valid until the next sweep.
+   */
+  const ClearedRows& clearFullRows();
+
+  /**
+   * @brief Equality operator to compare two boards.
+   *
+   * @param other The other board to compare with.
+   * @return true if both boards have the same cells; false otherwise.
+   */
+  bool operator==(const Board& other) const {
+    return width_ == other.width_ && rows_ == other.rows_ &&
+           colors_ == other.colors_;
+  }
+
+  /**
+   * @brief Inequality operator to compare two boards.
+   *
+   * @param other The other board to compare with.
+   * @return true if the boards differ; false otherwise.
+   */
+  bool operator!=(const Board& other) const { return !(*this == other); }
+
+ private:
+  int width_;                         ///< Number of columns
+  int height_;                        ///< Number of rows
+  int words_;                         ///< Occupancy words per row
+  RowMask last_full_;                 ///< Mask of a full last word of a row
+  std::vector<RowMask> rows_;         ///< Occupancy words, row by row
+  std::vector<std::uint8_t> colors_;  ///< Color plane, 0 for empty cells
+  Heights heights_;                   ///< Height of every column
+  ClearedRows cleared_;               ///< Rows removed by the last sweep
+
+  const RowMask* rowWords(int row) const {
+    return rows_.data() + static_cast<size_t>(row) * words_;
+  }
+
+  RowMask* rowWords(int row) {
+    return rows_.data() + static_cast<size_t>(row) * words_;
+  }
+
+  /**
+   * @brief Recomputes the height of a column from its cells.
+   *
+   * @param col The column to recompute.
+   */
+  void updateHeight(int col);
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_TETRIS_BOARD_H_
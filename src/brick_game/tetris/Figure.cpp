@@ -2,9 +2,9 @@
 
 namespace s21 {
 
-Figure::Figure() {
-  cords_.resize(4);
-  setRandomShape();
+Figure::Figure(int field_width, int field_height)
+    : field_width_(field_width), field_height_(field_height) {
+  setShape(Shape::T);
 }
 
 bool Figure::operator==(const Figure &other) const {
@@ -15,105 +15,67 @@ bool Figure::operator!=(const Figure &other) const { return !(*this == other); }
 
 void Figure::setShape(Shape s) {
   shape_ = s;
+  rotation_ = 0;
+  pivot_ = Cords(field_width_ / 2, -1);
+  if (pivot_.y_ + getBounds().min_y < 1) pivot_.y_ = 1 - getBounds().min_y;
   setShapeCords();
-  while (getMinY() < 1) moveDown();
 }
 
 void Figure::setShapeCords() {
-  int cur_shape = static_cast<int>(shape_);
+  const auto &offsets =
+      FigureCords::rotationMatrix[static_cast<int>(shape_)][rotation_];
   for (int i = 0; i < 4; i++) {
-    cords_[i].x_ = FigureCords::cordsMatrix[cur_shape][i].x_ +
-                   (ConstSizes::field_width / 2);
-    cords_[i].y_ = FigureCords::cordsMatrix[cur_shape][i].y_ - 1;
+    cords_[i].x_ = pivot_.x_ + offsets[i].x_;
+    cords_[i].y_ = pivot_.y_ + offsets[i].y_;
   }
 }
 
-void Figure::setRandomShape() {
-  std::random_device rd;
-  std::default_random_engine gen(rd());
-  std::uniform_int_distribution<int> distribution(1, 7);
-  auto rand_shape = static_cast<Shape>(distribution(gen));
-  setShape(rand_shape);
-}
-
-std::vector<Cords> Figure::getCords() const { return cords_; };
-
 Shape Figure::getShape() const { return shape_; }
 
-void Figure::Rotate() {
-  if (shape_ == Shape::O) return;
-  int center_x = getMaxX() - 1;
-  int center_y = getMaxY() - 1;
-
-  int rotationMatrix[2][2] = {{0, -1}, {1, 0}};
-
-  for (int i = 0; i < 4; i++) {
-    int x = cords_[i].x_ - (center_x);
-    int y = cords_[i].y_ - (center_y);
-    cords_[i].x_ =
-        (x * rotationMatrix[0][0] + y * rotationMatrix[0][1]) + (center_x);
-    cords_[i].y_ =
-        (x * rotationMatrix[1][0] + y * rotationMatrix[1][1]) + (center_y);
-  }
+void Figure::setRotation(int rotation) {
+  rotation_ = (rotation % FigureCords::kRotations + FigureCords::kRotations) %
+              FigureCords::kRotations;
   adjustPosition();
 }
 
-void Figure::adjustPosition() {
-  while (getMinY() <= 0) moveDown();
-  while (getMaxX() >= static_cast<int>(ConstSizes::field_width)) moveLeft();
-  while (getMinX() < 0) moveRight();
-}
+void Figure::Rotate() { setRotation(rotation_ + 1); }
 
-int Figure::getMinX() {
-  int res = cords_[0].x_;
-  for (int i = 0; i < 4; i++) {
-    res = std::min(res, cords_[i].x_);
-  }
-  return res;
+void Figure::shift(int dx, int dy) {
+  pivot_.x_ += dx;
+  pivot_.y_ += dy;
+  setShapeCords();
 }
 
-int Figure::getMaxX() {
-  int res = cords_[0].x_;
-  for (int i = 0; i < 4; i++) {
-    res = std::max(res, cords_[i].x_);
+void Figure::adjustPosition() {
+  const auto &b = getBounds();
+  if (pivot_.y_ + b.min_y <= 0) pivot_.y_ = 1 - b.min_y;
+  if (pivot_.x_ + b.max_x >= field_width_) {
+    pivot_.x_ = field_width_ - 1 - b.max_x;
   }
-  return res;
+  if (pivot_.x_ + b.min_x < 0) pivot_.x_ = -b.min_x;
+  setShapeCords();
 }
 
-int Figure::getMinY() {
-  int res = cords_[0].y_;
-  for (int i = 0; i < 4; i++) {
-    res = std::min(res, cords_[i].y_);
-  }
-  return res;
-}
+int Figure::getMinX() const { return pivot_.x_ + getBounds().min_x; }
 
-int Figure::getMaxY() {
-  int res = cords_[0].y_;
-  for (int i = 0; i < 4; i++) {
-    res = std::max(res, cords_[i].y_);
-  }
-  return res;
-}
+int Figure::getMaxX() const { return pivot_.x_ + getBounds().max_x; }
+
+int Figure::getMinY() const { return pivot_.y_ + getBounds().min_y; }
+
+int Figure::getMaxY() const { return pivot_.y_ + getBounds().max_y; }
 
 void Figure::moveDown() {
-  if (getMaxY() >= ConstSizes::field_height) return;
-  for (auto &i : cords_) {
-    i.y_ += 1;
-  }
+  if (getMaxY() >= field_height_) return;
+  shift(0, 1);
 }
 
 void Figure::moveLeft() {
   if (getMinX() < 1) return;
-  for (auto &i : cords_) {
-    i.x_ -= 1;
-  }
+  shift(-1, 0);
 }
 
 void Figure::moveRight() {
-  if (getMaxX() == ConstSizes::field_width - 1) return;
-  for (auto &i : cords_) {
-    i.x_ += 1;
-  }
+  if (getMaxX() == field_width_ - 1) return;
+  shift(1, 0);
 }
 }  // namespace s21
\ No newline at end of file
@@ -2,11 +2,10 @@
 #define BRICKGAME_TETRIS_FIGURE_H_
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
-#include <ctime>
-#include <random>
-#include <vector>
+#include <type_traits>
 
 #include "../base/BaseConstants.h"
 
@@ -14,7 +13,23 @@ namespace s21 {
 enum class Shape { Z = 1, S, L, J, T, O, I, EMPTY };
 
 namespace FigureCords {
-static const Cords cordsMatrix[8][4] = {
+/// @brief The number of rotation states of every shape.
+constexpr int kRotations = 4;
+
+/// @brief The cells of a figure in one rotation state, relative to its pivot.
+using CellOffsets = std::array<Cords, 4>;
+
+/**
+ * @brief Bounding box of a rotation state, relative to the figure pivot.
+ */
+struct Bounds {
+  int min_x;
+  int max_x;
+  int min_y;
+  int max_y;
+};
+
+constexpr Cords cordsMatrix[8][4] = {
     {{0, 0}, {0, 0}, {0, 0}, {0, 0}},     // empty
     {{0, -1}, {0, 0}, {-1, 0}, {-1, 1}},  // Z
     {{0, -1}, {0, 0}, {1, 0}, {1, 1}},    // S
@@ -24,14 +39,78 @@ static const Cords cordsMatrix[8][4] = {
     {{0, 0}, {1, 0}, {0, 1}, {1, 1}},     // O
     {{0, -1}, {0, 0}, {0, 1}, {0, 2}},    // I
 };
-};
+
+/**
+ * @brief Builds the cells of every shape in every rotation state.
+ *
+ * Each state turns the previous one clockwise by a quarter around the pivot.
+ * The O shape keeps its base cells in every state.
+ */
+constexpr std::array<std::array<CellOffsets, kRotations>, 8>
+makeRotationTable() {
+  std::array<std::array<CellOffsets, kRotations>, 8> table{};
+  for (int shape = 0; shape < 8; ++shape) {
+    const bool rotates = shape != static_cast<int>(Shape::O);
+    for (int i = 0; i < 4; ++i) {
+      table[shape][0][i] = cordsMatrix[shape][i];
+    }
+    for (int r = 1; r < kRotations; ++r) {
+      for (int i = 0; i < 4; ++i) {
+        const Cords& prev = table[shape][r - 1][i];
+        table[shape][r][i] = rotates ? Cords(-prev.y_, prev.x_) : prev;
+      }
+    }
+  }
+  return table;
+}
+
+/**
+ * @brief Builds the bounding box of every shape in every rotation state.
+ */
+constexpr std::array<std::array<Bounds, kRotations>, 8> makeBoundsTable() {
+  constexpr auto cells = makeRotationTable();
+  std::array<std::array<Bounds, kRotations>, 8> table{};
+  for (int shape = 0; shape < 8; ++shape) {
+    for (int r = 0; r < kRotations; ++r) {
+      Bounds b{cells[shape][r][0].x_, cells[shape][r][0].x_,
+               cells[shape][r][0].y_, cells[shape][r][0].y_};
+      for (const auto& c : cells[shape][r]) {
+        b.min_x = std::min(b.min_x, c.x_);
+        b.max_x = std::max(b.max_x, c.x_);
+        b.min_y = std::min(b.min_y, c.y_);
+        b.max_y = std::max(b.max_y, c.y_);
+      }
+      table[shape][r] = b;
+    }
+  }
+  return table;
+}
+
+/// @brief Cells of every shape in every rotation state.
+constexpr auto rotationMatrix = makeRotationTable();
+
+/// @brief Bounding boxes of every shape in every rotation state.
+constexpr auto boundsMatrix = makeBoundsTable();
+
+/// @brief Shifts tried in order when a rotated figure hits the field.
+constexpr Cords kickTable[] = {{0, 0}, {-1, 0}, {1, 0}, {-2, 0}, {2, 0}};
+}  // namespace FigureCords
 
 class Figure {
  public:
+  /// @brief The cells of a figure, stored inline.
+  using CordsArray = std::array<Cords, 4>;
+
   /**
    * @brief Constructs a new Figure object with a default shape.
+   *
+   * The model deals the actual shapes from its piece bag.
+   *
+   * @param field_width The number of columns of the field.
+   * @param field_height The number of rows of the field.
    */
-  Figure();
+  explicit Figure(int field_width = ConstSizes::field_width,
+                  int field_height = ConstSizes::field_height);
 
   /**
    * @brief Default destructor.
@@ -62,11 +141,6 @@ class Figure {
    */
   void setShape(Shape s);
 
-  /**
-   * @brief Sets a random shape for the figure.
-   */
-  void setRandomShape();
-
   /**
    * @brief Gets the current shape of the figure.
    *
@@ -77,15 +151,37 @@ class Figure {
   /**
    * @brief Gets the coordinates of the figure.
    *
-   * @return A vector of coordinates representing the figure.
+   * @return A reference to the coordinates representing the figure.
    */
-  std::vector<Cords> getCords() const;
+  const CordsArray& getCords() const { return cords_; }
 
   /**
-   * @brief Rotates the figure.
+   * @brief Gets the current rotation state of the figure.
+   *
+   * @return The rotation state, from 0 to FigureCords::kRotations - 1.
+   */
+  int getRotation() const { return rotation_; }
+
+  /**
+   * @brief Sets the rotation state of the figure and keeps it within bounds.
+   *
+   * @param rotation The rotation state, from 0 to FigureCords::kRotations - 1.
+   */
+  void setRotation(int rotation);
+
+  /**
+   * @brief Rotates the figure clockwise to its next rotation state.
    */
   void Rotate();
 
+  /**
+   * @brief Shifts the figure without any bounds check.
+   *
+   * @param dx The horizontal shift.
+   * @param dy The vertical shift.
+   */
+  void shift(int dx, int dy);
+
   /**
    * @brief Adjusts the position of the figure to ensure it is within bounds.
    */
@@ -111,39 +207,56 @@ class Figure {
    *
    * @return The minimum x-coordinate.
    */
-  int getMinX();
+  int getMinX() const;
 
   /**
    * @brief Gets the minimum y-coordinate of the figure.
    *
    * @return The minimum y-coordinate.
    */
-  int getMinY();
+  int getMinY() const;
 
   /**
    * @brief Gets the maximum x-coordinate of the figure.
    *
    * @return The maximum x-coordinate.
    */
-  int getMaxX();
+  int getMaxX() const;
 
   /**
    * @brief Gets the maximum y-coordinate of the figure.
    *
    * @return The maximum y-coordinate.
    */
-  int getMaxY();
+  int getMaxY() const;
 
  private:
-  Shape shape_;               ///< Current shape of the figure
-  std::vector<Cords> cords_;  ///< Coordinates of the figure
+  Shape shape_;       ///< Current shape of the figure
+  int rotation_;      ///< Current rotation state of the figure
+  Cords pivot_;       ///< Position of the figure pivot on the field
+  CordsArray cords_;  ///< Coordinates of the figure
+  int field_width_;   ///< Number of columns of the field
+  int field_height_;  ///< Number of rows of the field
+
+  /**
+   * @brief Gets the bounding box of the current rotation state.
+   *
+   * @return The bounding box relative to the pivot.
+   */
+  const FigureCords::Bounds& getBounds() const {
+    return FigureCords::boundsMatrix[static_cast<int>(shape_)][rotation_];
+  }
 
   /**
-   * @brief Sets the coordinates of the figure based on its shape.
+   * @brief Sets the coordinates of the figure based on its shape, rotation
+   * and pivot.
    */
   void setShapeCords();
 };
 
+static_assert(std::is_trivially_copyable<Figure>::value,
+              "Figure copies must not allocate");
+
 }  // namespace s21
 
 #endif  // BRICKGAME_TETRIS_FIGURE_H_
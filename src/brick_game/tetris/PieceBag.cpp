@@ -0,0 +1,34 @@
+#include "PieceBag.h"
+
+#include <utility>
+
+namespace s21 {
+
+void PieceBag::reset(Random &rng) {
+  head_ = 0;
+  left_ = 0;
+  refill(rng);
+  refill(rng);
+}
+
+Shape PieceBag::next(Random &rng) {
+  const Shape shape = queue_[head_];
+  head_ = (head_ + 1) % kQueueSize;
+  if (--left_ == kBagSize) refill(rng);
+  return shape;
+}
+
+void PieceBag::refill(Random &rng) {
+  const size_t start = head_ + left_;
+  for (size_t i = 0; i < kBagSize; ++i) {
+    queue_[(start + i) % kQueueSize] = static_cast<Shape>(i + 1);
+  }
+  for (size_t i = kBagSize - 1; i > 0; --i) {
+    const size_t j = static_cast<size_t>(rng.uniform(0, static_cast<int>(i)));
+    std::swap(queue_[(start + i) % kQueueSize],
+              queue_[(start + j) % kQueueSize]);
+  }
+  left_ += kBagSize;
+}
+
+}  // namespace s21
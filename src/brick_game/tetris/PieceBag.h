@@ -0,0 +1,66 @@
+#ifndef BRICKGAME_TETRIS_PIECE_BAG_H_
+#define BRICKGAME_TETRIS_PIECE_BAG_H_
+
+#include <array>
+#include <cstddef>
+
+#include "../base/Random.h"
+#include "Figure.h"
+
+namespace s21 {
+
+/**
+ * @brief 7-bag randomizer for the Tetris piece sequence.
+ *
+ * Every block of seven pieces holds each shape exactly once in a shuffled
+ * order. Two blocks are kept queued, and a new block is shuffled in only
+ * when the older one runs out, so the upcoming pieces can be previewed.
+ */
+class PieceBag {
+ public:
+  /// @brief The number of pieces in one bag.
+  static constexpr size_t kBagSize = 7;
+
+  /// @brief The number of pieces kept queued.
+  static constexpr size_t kQueueSize = 2 * kBagSize;
+
+  /**
+   * @brief Discards the queue and deals two fresh bags.
+   *
+   * @param rng The generator used to shuffle the bags.
+   */
+  void reset(Random& rng);
+
+  /**
+   * @brief Takes the next piece from the queue.
+   *
+   * @param rng The generator used to shuffle a new bag when one runs out.
+   * @return The shape of the next piece.
+   */
+  Shape next(Random& rng);
+
+  /**
+   * @brief Looks at an upcoming piece without taking it.
+   *
+   * @param i The position in the queue, 0 for the next piece. At most
+   * kBagSize pieces are guaranteed to be queued.
+   * @return The shape at that position.
+   */
+  Shape peek(size_t i) const { return queue_[(head_ + i) % kQueueSize]; }
+
+ private:
+  std::array<Shape, kQueueSize> queue_{};  ///< Ring of the upcoming pieces
+  size_t head_{};                          ///< Position of the next piece
+  size_t left_{};                          ///< Pieces left in the queue
+
+  /**
+   * @brief Shuffles a full bag into the queue after the queued pieces.
+   *
+   * @param rng The generator used to shuffle the bag.
+   */
+  void refill(Random& rng);
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_TETRIS_PIECE_BAG_H_
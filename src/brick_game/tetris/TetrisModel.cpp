@@ -1,83 +1,106 @@
 #include "TetrisModel.h"
+
 #include <algorithm>
+
 namespace s21 {
 
-TetrisModel::TetrisModel() {
-  initEventHandlersMatrix();
+TetrisModel::TetrisModel(int width, int height)
+    : tetris_data_(fitFieldSize(width), fitFieldSize(height)) {
+  initChangeLog(tetris_data_.game_field.width(),
+                tetris_data_.game_field.height());
   setDefault();
   tetris_data_.best_score = readBestScore("TetrisScore.txt");
 }
 
 TetrisModel::~TetrisModel() {
-  writeBestScore(tetris_data_.best_score, "TetrisScore.txt");
-  tetris_data_.game_field.clear();
+  if (isScoreSaving()) {
+    writeBestScore(tetris_data_.best_score, "TetrisScore.txt");
+  }
 }
 
-void TetrisModel::initEventHandlersMatrix() {
+constexpr StateActionMatrix<TetrisModel>
+TetrisModel::makeEventHandlersMatrix() {
+  StateActionMatrix<TetrisModel> matrix;
+
   /* START STATE */
-  EventsMatrix[GameState::START][UserAction::SPACE_BTN] = &TetrisModel::Start;
-  EventsMatrix[GameState::START][UserAction::ENTER_BTN] = &TetrisModel::Start;
-  EventsMatrix[GameState::START][UserAction::ESC_BTN] = &TetrisModel::ExitGame;
+  matrix[GameState::START][UserAction::SPACE_BTN] = &TetrisModel::Start;
+  matrix[GameState::START][UserAction::ENTER_BTN] = &TetrisModel::Start;
+  matrix[GameState::START][UserAction::ESC_BTN] = &TetrisModel::ExitGame;
 
   /* |SPAWN|COLLIDE|EXIT|GAMEOVER| STATES */
   for (int i = 0; i < USER_ACTIONS_CNT; i++) {
-    EventsMatrix[GameState::SPAWN][static_cast<UserAction>(i)] =
+    matrix[GameState::SPAWN][static_cast<UserAction>(i)] =
         &TetrisModel::SpawnFigure;
 
-    EventsMatrix[GameState::COLLIDE][static_cast<UserAction>(i)] =
+    matrix[GameState::COLLIDE][static_cast<UserAction>(i)] =
         &TetrisModel::Collide;
 
-    EventsMatrix[GameState::EXIT][static_cast<UserAction>(i)] =
+    matrix[GameState::EXIT][static_cast<UserAction>(i)] =
         &TetrisModel::ExitGame;
 
-    EventsMatrix[GameState::GAMEOVER][static_cast<UserAction>(i)] =
+    matrix[GameState::GAMEOVER][static_cast<UserAction>(i)] =
         &TetrisModel::GameOver;
   }
 
   /* MOVING STATE */
-  EventsMatrix[GameState::MOVING][UserAction::UP_BTN] =
-      &TetrisModel::RotateFigure;
-  EventsMatrix[GameState::MOVING][UserAction::DOWN_BTN] =
+  matrix[GameState::MOVING][UserAction::UP_BTN] = &TetrisModel::RotateFigure;
+  matrix[GameState::MOVING][UserAction::DOWN_BTN] =
       &TetrisModel::MoveFigureDown;
-  EventsMatrix[GameState::MOVING][UserAction::RIGHT_BTN] =
+  matrix[GameState::MOVING][UserAction::RIGHT_BTN] =
       &TetrisModel::MoveFigureRight;
-  EventsMatrix[GameState::MOVING][UserAction::LEFT_BTN] =
+  matrix[GameState::MOVING][UserAction::LEFT_BTN] =
       &TetrisModel::MoveFigureLeft;
-  EventsMatrix[GameState::MOVING][UserAction::SPACE_BTN] =
-      &TetrisModel::DropFigure;
-  EventsMatrix[GameState::MOVING][UserAction::TAB_BTN] = &TetrisModel::Pause;
-  EventsMatrix[GameState::MOVING][UserAction::ESC_BTN] = &TetrisModel::ExitGame;
+  matrix[GameState::MOVING][UserAction::SPACE_BTN] = &TetrisModel::DropFigure;
+  matrix[GameState::MOVING][UserAction::TAB_BTN] = &TetrisModel::Pause;
+  matrix[GameState::MOVING][UserAction::ESC_BTN] = &TetrisModel::ExitGame;
 
   /* PAUSE STATE */
-  EventsMatrix[GameState::PAUSE][UserAction::ENTER_BTN] = &TetrisModel::Unpause;
-  EventsMatrix[GameState::PAUSE][UserAction::TAB_BTN] = &TetrisModel::Unpause;
-  EventsMatrix[GameState::PAUSE][UserAction::ESC_BTN] = &TetrisModel::ExitGame;
+  matrix[GameState::PAUSE][UserAction::ENTER_BTN] = &TetrisModel::Unpause;
+  matrix[GameState::PAUSE][UserAction::TAB_BTN] = &TetrisModel::Unpause;
+  matrix[GameState::PAUSE][UserAction::ESC_BTN] = &TetrisModel::ExitGame;
+
+  return matrix;
 }
 
-void TetrisModel::updateData(UserAction action) {
-  tetris_data_.was_modified = false;
-  GameData tmp = tetris_data_;
+constexpr StateActionMatrix<TetrisModel> TetrisModel::EventsMatrix =
+    TetrisModel::makeEventHandlersMatrix();
 
-  long long cur_time_ = last_move_time_;
-  if (tetris_data_.game_state != GameState::PAUSE) cur_time_ = getCurTime();
+void TetrisModel::updateData(UserAction action) { update<false>(action); }
 
-  using Action = void (TetrisModel::*)();
-  Action cur_func = EventsMatrix[tetris_data_.game_state][action];
+template <bool kRuntimeDispatch>
+void TetrisModel::update(UserAction action) {
+  const Version version = getVersion();
 
-  if (cur_func) (this->*cur_func)();
+  const long long cur_time = getCurTime();
 
-  if (tetris_data_.game_state == GameState::MOVING) {
-    if (cur_time_ - last_move_time_ >= cur_interval_) {
-      last_move_time_ = cur_time_;
-      if (checkCollision()) updateField();
-      MoveFigureDown();
-    }
-    updateLvl();
+  using Dispatcher = StateActionDispatcher<TetrisModel, EventsMatrix>;
+  if constexpr (kRuntimeDispatch) {
+    Dispatcher::dispatchRuntime(this, tetris_data_.game_state, action);
+  } else {
+    Dispatcher::dispatch(this, tetris_data_.game_state, action);
   }
 
-  if (tetris_data_ != tmp) tetris_data_.was_modified = true;
+  runTimedSteps(cur_time);
+
+  tetris_data_.was_modified = getVersion() != version;
+}
+
+void TetrisModel::runTimedSteps(long long time) {
+  if (tetris_data_.game_state != GameState::MOVING) return;
+
+  /* every elapsed gravity step falls, the rest of the time carries over */
+  gravity_.limitBacklog(time);
+  while (tetris_data_.game_state == GameState::MOVING && gravity_.step(time)) {
+    if (checkCollision()) updateField();
+    MoveFigureDown();
+  }
+  updateLvl();
 }
 
+/* the benchmarks call both dispatches */
+template void TetrisModel::update<false>(UserAction action);
+template void TetrisModel::update<true>(UserAction action);
+
 void TetrisModel::updateField() {
   placeFigureUp();
   updateScore(checkCompleteLines());
@@ -99,203 +122,273 @@ void TetrisModel::updateScore(size_t lines) {
     case 4:
       tetris_data_.cur_score += 1500;
       break;
+    default:
+      return;
   }
+  touch(ModelComponent::HUD);
+  markHud(HudItem::SCORE);
 
   if (tetris_data_.cur_score >= tetris_data_.best_score) {
     tetris_data_.best_score = tetris_data_.cur_score;
+    markHud(HudItem::BEST_SCORE);
   }
 }
 
 void TetrisModel::updateLvl() {
   if (tetris_data_.lvl < 10 && tetris_data_.cur_score >= 600) {
-    tetris_data_.lvl = (tetris_data_.cur_score / 600) + 1;
+    const size_t lvl = (tetris_data_.cur_score / 600) + 1;
+    if (lvl != tetris_data_.lvl) {
+      touch(ModelComponent::HUD);
+      markHud(HudItem::LEVEL);
+    }
+    tetris_data_.lvl = lvl;
   }
-  cur_interval_ = ConstSizes::levels_intervals_ms[tetris_data_.lvl - 1];
+  gravity_.setInterval(ConstSizes::levels_intervals_ms[tetris_data_.lvl - 1]);
 }
 
 size_t TetrisModel::checkCompleteLines() {
-  size_t cnt = 0;
-
-  for (int i = 0; i < ConstSizes::field_height; ++i) {
-    bool completed = true;
-    for (int j = 0; j < ConstSizes::field_width; ++j) {
-      if (!tetris_data_.game_field[i][j].first) {
-        completed = false;
-        break;
-      }
-    }
-    if (completed) {
-      clearLine(i);
-      cnt++;
-    }
-  }
-  return cnt;
+  tetris_data_.cleared_rows = clearLines();
+  if (!tetris_data_.cleared_rows.empty()) touch(ModelComponent::FIELD);
+  tetris_data_.lines += tetris_data_.cleared_rows.size();
+  return tetris_data_.cleared_rows.size();
 }
 
-void TetrisModel::clearLine(int i) {
-  tetris_data_.game_field.erase(tetris_data_.game_field.begin() + i);
-  tetris_data_.game_field.insert(
-      tetris_data_.game_field.begin(),
-      std::vector<std::pair<bool, int>>(ConstSizes::field_width, {false, 0}));
+const Board::ClearedRows& TetrisModel::clearLines() {
+  Board& field = tetris_data_.game_field;
+  const auto& heights = field.getHeights();
+  const int top =
+      field.height() - *std::max_element(heights.begin(), heights.end());
+
+  const Board::ClearedRows& cleared = field.clearFullRows();
+  if (cleared.empty()) return cleared;
+
+  /* rows between the old top of the stack and the lowest cleared row moved */
+  for (int row = top; row <= cleared.front(); ++row) {
+    for (int col = 0; col < field.width(); ++col) markCell(col, row);
+  }
+  return cleared;
 }
 
 TetrisModel::GameData& TetrisModel::getModelData() { return tetris_data_; }
 
 void TetrisModel::placeFigureUp() {
+  const int color = static_cast<int>(tetris_data_.cur_figure.getShape());
   for (const auto& cords : tetris_data_.cur_figure.getCords()) {
-    tetris_data_.game_field[cords.y_ - 1][cords.x_].first = true;
-    tetris_data_.game_field[cords.y_ - 1][cords.x_].second =
-        static_cast<int>(tetris_data_.cur_figure.getShape());
+    tetris_data_.game_field.setCell(cords.y_ - 1, cords.x_, color);
   }
+  markFigure(tetris_data_.cur_figure);
+  touch(ModelComponent::FIELD);
 }
 
 void TetrisModel::setDefault() {
   tetris_data_.cur_score = 0;
+  tetris_data_.lines = 0;
   tetris_data_.lvl = 1;
-  tetris_data_.game_state = GameState::START;
-  tetris_data_.cur_figure.setRandomShape();
-  tetris_data_.next_figure.setRandomShape();
+  setState(GameState::START);
+  bag_.reset(rng_);
+  tetris_data_.cur_figure.setShape(bag_.next(rng_));
+  tetris_data_.next_figure.setShape(bag_.next(rng_));
   tetris_data_.projection = tetris_data_.cur_figure;
 
   initField();
   initProjection();
 
-  last_move_time_ = getCurTime();
-  cur_interval_ = ConstSizes::levels_intervals_ms[0];
+  gravity_.restart(getCurTime());
+  gravity_.setInterval(ConstSizes::levels_intervals_ms[0]);
+  touchAll();
+  markAll();
 }
 
-void TetrisModel::initField() {
-  tetris_data_.game_field.resize(
-      ConstSizes::field_height,
-      std::vector<std::pair<bool, int>>(ConstSizes::field_width, {false, 0}));
-  for (int i = 0; i < ConstSizes::field_height; ++i) {
-    for (int j = 0; j < ConstSizes::field_width; ++j) {
-      tetris_data_.game_field[i][j].first = false;
-      tetris_data_.game_field[i][j].second = static_cast<int>(Shape::EMPTY);
-    }
-  }
-}
+void TetrisModel::initField() { tetris_data_.game_field.clear(); }
 
 void TetrisModel::initProjection() {
   tetris_data_.projection = tetris_data_.cur_figure;
-  while (FigureCanMove(tetris_data_.projection, UserAction::DOWN_BTN)) {
-    tetris_data_.projection.moveDown();
+  tetris_data_.projection.shift(0, dropDistance(tetris_data_.cur_figure));
+}
+
+int TetrisModel::dropDistance(const Figure& piece) const {
+  const Board& field = tetris_data_.game_field;
+  int distance = field.height();
+  for (const auto& cords : piece.getCords()) {
+    const int row = cords.y_ - 1;
+    const int surface = field.getSurfaceRow(cords.x_);
+    if (row >= surface) {
+      /* tucked under an overhang, the height map does not apply */
+      distance = 0;
+      while (figureFits(piece, 0, distance + 1)) ++distance;
+      return distance;
+    }
+    distance = std::min(distance, surface - 1 - row);
   }
+  return distance;
+}
+
+const Board::Heights& TetrisModel::getColumnHeights() const {
+  return tetris_data_.game_field.getHeights();
 }
 
 bool TetrisModel::FigureCanMove(const Figure& piece, UserAction action) {
-  bool res = true;
+  switch (action) {
+    case UserAction::DOWN_BTN:
+      return figureFits(piece, 0, 1);
+    case UserAction::LEFT_BTN:
+      return figureFits(piece, -1, 0);
+    case UserAction::RIGHT_BTN:
+      return figureFits(piece, 1, 0);
+    default:
+      return true;
+  }
+}
+
+bool TetrisModel::figureFits(const Figure& piece, int dx, int dy) const {
+  const Board& field = tetris_data_.game_field;
   for (const auto& cords : piece.getCords()) {
-    switch (action) {
-      case UserAction::DOWN_BTN:
-        if (cords.y_ == ConstSizes::field_height ||
-            tetris_data_.game_field[cords.y_][cords.x_].first) {
-          res = false;
-        }
-        break;
-      case UserAction::LEFT_BTN:
-        if (cords.x_ < 1 ||
-            tetris_data_.game_field[cords.y_ - 1][cords.x_ - 1].first) {
-          res = false;
-        }
-        break;
-      case UserAction::RIGHT_BTN:
-        if (cords.x_ == ConstSizes::field_width - 1 ||
-            tetris_data_.game_field[cords.y_ - 1][cords.x_ + 1].first) {
-          res = false;
-        }
-        break;
-      default:
-        break;
+    const int col = cords.x_ + dx;
+    const int row = cords.y_ - 1 + dy;
+    if (col < 0 || col >= field.width() || row >= field.height()) {
+      return false;
     }
-    if (!res) break;
+    if (row >= 0 && field.isFilled(row, col)) return false;
   }
-  return res;
+  return true;
 }
 
-bool TetrisModel::checkCollision() {
-  bool collision = false;
-  for (const auto& cords : tetris_data_.cur_figure.getCords()) {
-    if (cords.y_ == ConstSizes::field_height) {
-      collision = true;
-      break;
-    }
-    if (tetris_data_.game_field[cords.y_][cords.x_].first) {
-      collision = true;
-      break;
-    }
+long long TetrisModel::getNextDeadline() const {
+  switch (tetris_data_.game_state) {
+    case GameState::MOVING:
+      return gravity_.getDeadline();
+    case GameState::SPAWN:
+    case GameState::COLLIDE:
+      return getCurTime();
+    default:
+      return kNoDeadline;
   }
-  return collision;
+}
+
+int TetrisModel::getCellColor(int x, int y) const {
+  const auto covers = [x, y](const Figure& piece) {
+    const auto& cords = piece.getCords();
+    return std::any_of(cords.begin(), cords.end(), [x, y](const Cords& c) {
+      return c.x_ == x && c.y_ - 1 == y;
+    });
+  };
+  if (covers(tetris_data_.cur_figure)) {
+    return static_cast<int>(tetris_data_.cur_figure.getShape());
+  }
+  if (tetris_data_.game_field.isFilled(y, x)) {
+    return tetris_data_.game_field.getColor(y, x);
+  }
+  if (covers(tetris_data_.projection)) return kProjectionColor;
+  return 0;
+}
+
+void TetrisModel::markFigure(const Figure& piece) {
+  for (const auto& cords : piece.getCords()) markCell(cords.x_, cords.y_ - 1);
+}
+
+void TetrisModel::markFigures() {
+  markFigure(tetris_data_.cur_figure);
+  markFigure(tetris_data_.projection);
+}
+
+bool TetrisModel::checkCollision() {
+  return !figureFits(tetris_data_.cur_figure, 0, 1);
 }
 
 void TetrisModel::SpawnFigure() {
-  tetris_data_.game_state = GameState::MOVING;
+  setState(GameState::MOVING);
+  markFigures();
   tetris_data_.cur_figure = tetris_data_.next_figure;
-  tetris_data_.next_figure.setRandomShape();
-  tetris_data_.projection = tetris_data_.cur_figure;
+  tetris_data_.next_figure.setShape(bag_.next(rng_));
   initProjection();
-  if (checkCollision()) tetris_data_.game_state = GameState::GAMEOVER;
+  markFigures();
+  markHud(HudItem::NEXT_FIGURE);
+  touch(ModelComponent::FIGURE);
+  if (checkCollision()) setState(GameState::GAMEOVER);
 }
 
 void TetrisModel::MoveFigureLeft() {
   if (FigureCanMove(tetris_data_.cur_figure, UserAction::LEFT_BTN)) {
+    markFigures();
     tetris_data_.cur_figure.moveLeft();
     initProjection();
+    markFigures();
+    touch(ModelComponent::FIGURE);
   }
 }
 
 void TetrisModel::MoveFigureRight() {
   if (FigureCanMove(tetris_data_.cur_figure, UserAction::RIGHT_BTN)) {
+    markFigures();
     tetris_data_.cur_figure.moveRight();
     initProjection();
+    markFigures();
+    touch(ModelComponent::FIGURE);
   }
 }
 
 void TetrisModel::MoveFigureDown() {
   if (FigureCanMove(tetris_data_.cur_figure, UserAction::DOWN_BTN)) {
+    markFigures();
     tetris_data_.cur_figure.moveDown();
     initProjection();
+    markFigures();
+    touch(ModelComponent::FIGURE);
   }
 }
 
 void TetrisModel::DropFigure() {
-  tetris_data_.cur_figure = tetris_data_.projection;
+  tetris_data_.cur_figure.shift(0, dropDistance(tetris_data_.cur_figure));
   updateField();
 }
 
 void TetrisModel::RotateFigure() {
-  auto temp = tetris_data_.cur_figure;
-  tetris_data_.cur_figure.Rotate();
-
-  const auto& cords = tetris_data_.cur_figure.getCords();
-
-  bool rotate_possible =
-      !std::any_of(cords.begin(), cords.end(), [this](const auto& cord) {
-        return tetris_data_.game_field[cord.y_ - 1][cord.x_].first;
-      });
-
-  if (!rotate_possible) {
-    tetris_data_.cur_figure = temp;
+  auto rotated = tetris_data_.cur_figure;
+  rotated.Rotate();
+
+  for (const auto& kick : FigureCords::kickTable) {
+    if (figureFits(rotated, kick.x_, kick.y_)) {
+      rotated.shift(kick.x_, kick.y_);
+      markFigures();
+      tetris_data_.cur_figure = rotated;
+      initProjection();
+      markFigures();
+      touch(ModelComponent::FIGURE);
+      break;
+    }
   }
-  initProjection();
+}
+
+void TetrisModel::setState(GameState state) {
+  if (tetris_data_.game_state == state) return;
+  tetris_data_.game_state = state;
+  touch(ModelComponent::STATE);
 }
 
 void TetrisModel::Start() {
   setDefault();
-  tetris_data_.game_state = GameState::SPAWN;
+  setState(GameState::SPAWN);
 }
 
-void TetrisModel::ExitGame() { tetris_data_.game_state = GameState::EXIT; }
+void TetrisModel::ExitGame() { setState(GameState::EXIT); }
 
-void TetrisModel::Pause() { tetris_data_.game_state = GameState::PAUSE; }
+void TetrisModel::Pause() {
+  gravity_.pause(getCurTime());
+  setState(GameState::PAUSE);
+}
 
-void TetrisModel::Unpause() { tetris_data_.game_state = GameState::MOVING; }
+void TetrisModel::Unpause() {
+  gravity_.resume(getCurTime());
+  setState(GameState::MOVING);
+}
 
 void TetrisModel::Collide() {
-  tetris_data_.game_state = GameState::SPAWN;
+  setState(GameState::SPAWN);
   updateField();
 }
 
-void TetrisModel::GameOver() { tetris_data_.game_state = GameState::EXIT; }
+void TetrisModel::GameOver() { setState(GameState::EXIT); }
+
+void TetrisModel::shiftTime(long long delta) { gravity_.shift(delta); }
 
 }  // namespace s21
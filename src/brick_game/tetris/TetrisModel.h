@@ -4,13 +4,18 @@
 #include <algorithm>
 
 #include "../base/BaseModel.h"
+#include "../base/FixedTimestep.h"
+#include "Board.h"
 #include "Figure.h"
-
+#include "PieceBag.h"
 
 namespace s21 {
 
 class TetrisModel : public BaseModel {
  public:
+  /// @brief Color index used for the projection of the current figure.
+  static constexpr int kProjectionColor = 8;
+
   /**
    * @brief Structure to hold the game data for Tetris including the current
    * score, level, game state, and figures.
@@ -18,30 +23,37 @@ class TetrisModel : public BaseModel {
   struct GameData {
     size_t cur_score;      ///< Current score of the game
     size_t best_score;     ///< Best score achieved in the game
+    size_t lines;          ///< Lines cleared in the current game
     size_t lvl;            ///< Current level of the game
     GameState game_state;  ///< Current state of the game
 
     Figure cur_figure;   ///< Current figure in play
     Figure next_figure;  ///< Next figure to be played
     Figure projection;   ///< Projection of the current figure
-    std::vector<std::vector<std::pair<bool, int>>>
-        game_field;  ///< The game field, with boolean for occupation and int
-                     ///< for the type
+    Board game_field;    ///< The game field, occupancy masks and colors
+
+    Board::ClearedRows cleared_rows;  ///< Rows cleared by the last figure
 
     bool was_modified;  ///< Flag for smooth console view
 
     /**
-     * @brief Default constructor initializing game data to default values.
+     * @brief Constructor initializing game data to default values.
+     *
+     * @param width The number of columns of the field.
+     * @param height The number of rows of the field.
      */
-    GameData()
+    explicit GameData(int width = ConstSizes::field_width,
+                      int height = ConstSizes::field_height)
         : cur_score(0),
           best_score(0),
+          lines(0),
           lvl(1),
           game_state(GameState::START),
-          cur_figure(),
-          next_figure(),
-          projection(),
-          game_field(),
+          cur_figure(width, height),
+          next_figure(width, height),
+          projection(width, height),
+          game_field(width, height),
+          cleared_rows(),
           was_modified(true) {}
 
     /**
@@ -70,8 +82,14 @@ class TetrisModel : public BaseModel {
 
   /**
    * @brief Constructs a new TetrisModel object.
+   *
+   * @param width The number of columns of the field, clamped to the
+   * supported range.
+   * @param height The number of rows of the field, clamped to the supported
+   * range.
    */
-  TetrisModel();
+  explicit TetrisModel(int width = ConstSizes::field_width,
+                       int height = ConstSizes::field_height);
 
   /**
    * @brief Destructor for TetrisModel.
@@ -83,12 +101,12 @@ class TetrisModel : public BaseModel {
    *
    * @param action The action performed by the user.
    */
-  void updateData(UserAction action);
+  void updateData(UserAction action) override;
 
   /**
    * @brief Resets the game data to its default values.
    */
-  void setDefault();
+  void setDefault() override;
 
   /**
    * @brief Returns the current game data.
@@ -97,17 +115,73 @@ class TetrisModel : public BaseModel {
    */
   GameData& getModelData();
 
+  /**
+   * @brief Returns the height of every column of the game field.
+   *
+   * @return Reference to the column height map.
+   */
+  const Board::Heights& getColumnHeights() const;
+
+  /**
+   * @brief Gets the color of a field cell with the figures drawn over it.
+   *
+   * @param x The column of the cell.
+   * @param y The row of the cell.
+   * @return The color index of the cell, 0 for an empty cell.
+   */
+  int getCellColor(int x, int y) const override;
+
+  /**
+   * @brief Gets the time of the next gravity step, or of the next state change
+   * when the game moves on by itself.
+   *
+   * @return The time in milliseconds on the model clock, or kNoDeadline
+   * while the game waits for input.
+   */
+  long long getNextDeadline() const override;
+
+ protected:
+  /**
+   * @brief Moves the model timers onto a clock that reads differently.
+   *
+   * @param delta The offset in milliseconds.
+   */
+  void shiftTime(long long delta) override;
+
+  /**
+   * @brief Takes the gravity steps due by a time.
+   *
+   * @param time The time in milliseconds on the model clock.
+   */
+  void runTimedSteps(long long time) override;
+
  private:
   GameData tetris_data_;        ///< The current game data
-  long long last_move_time_{};  ///< Time of the last move
-  long long cur_interval_{};    ///< Current time interval between moves
-  StateActionMatrix<TetrisModel>
+  FixedTimestep gravity_;       ///< Steps of the falling figure
+  PieceBag bag_;                ///< Sequence of the upcoming figures
+  static const StateActionMatrix<TetrisModel>
       EventsMatrix;  ///< Matrix to handle state actions
 
+  /// The benchmarks call update() with either dispatch
+  friend struct DispatchAccess;
+
   /**
-   * @brief Initializes the event handlers matrix.
+   * @brief Updates the game data, calling the handler of the current state
+   * through the compile-time dispatcher or through a lookup in EventsMatrix
+   * at run time. updateData() uses the dispatcher.
+   *
+   * @tparam kRuntimeDispatch Whether to look the handler up at run time.
+   * @param action The action performed by the user.
    */
-  void initEventHandlersMatrix();
+  template <bool kRuntimeDispatch>
+  void update(UserAction action);
+
+  /**
+   * @brief Builds the event handlers matrix at compile time.
+   *
+   * @return The matrix mapping each state and action to its handler.
+   */
+  static constexpr StateActionMatrix<TetrisModel> makeEventHandlersMatrix();
 
   /**
    * @brief Initializes the game field.
@@ -119,6 +193,14 @@ class TetrisModel : public BaseModel {
    */
   void initProjection();
 
+  /**
+   * @brief Computes how many rows a figure can fall before it lands.
+   *
+   * @param piece The figure to drop.
+   * @return The number of free rows below the figure.
+   */
+  int dropDistance(const Figure& piece) const;
+
   /**
    * @brief Updates the game field based on the current state.
    */
@@ -152,11 +234,11 @@ class TetrisModel : public BaseModel {
   size_t checkCompleteLines();
 
   /**
-   * @brief Clears a line in the game field.
+   * @brief Clears every complete line of the game field in one pass.
    *
-   * @param i The index of the line to clear.
+   * @return The cleared lines from the bottom up.
    */
-  void clearLine(int i);
+  const Board::ClearedRows& clearLines();
 
   /* FIGURES */
 
@@ -179,6 +261,29 @@ class TetrisModel : public BaseModel {
    */
   bool FigureCanMove(const Figure& piece, UserAction action);
 
+  /**
+   * @brief Checks if the figure fits the game field after a shift.
+   *
+   * @param piece The figure to check.
+   * @param dx The horizontal shift.
+   * @param dy The vertical shift.
+   * @return true if every shifted cell is inside the field and free; false
+   * otherwise.
+   */
+  bool figureFits(const Figure& piece, int dx, int dy) const;
+
+  /**
+   * @brief Logs the field cells covered by a figure as changed.
+   *
+   * @param piece The figure to log.
+   */
+  void markFigure(const Figure& piece);
+
+  /**
+   * @brief Logs the cells of the current figure and its projection as changed.
+   */
+  void markFigures();
+
   /**
    * @brief Moves the figure left by one unit.
    */
@@ -206,6 +311,13 @@ class TetrisModel : public BaseModel {
 
   /* STATES */
 
+  /**
+   * @brief Changes the game state and marks it as changed.
+   *
+   * @param state The new game state.
+   */
+  void setState(GameState state);
+
   /**
    * @brief Starts the game by initializing the game state.
    */
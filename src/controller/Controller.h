@@ -1,7 +1,10 @@
 #ifndef BRICKGAME_CONTROLLER_H_
 #define BRICKGAME_CONTROLLER_H_
 
+#include <vector>
+
 #include "../brick_game/base/BaseConstants.h"
+#include "SimulationThread.h"
 
 namespace s21 {
 
@@ -20,7 +23,7 @@ class Controller {
    *
    * @param model Pointer to the model object that this controller will manage.
    */
-  Controller(Model *model) : model_(model) {}
+  Controller(Model *model) : model_(model), simulation_(model, &input_) {}
 
   /**
    * @brief Default destructor.
@@ -38,9 +41,23 @@ class Controller {
   }
 
   /**
-   * @brief Resets the model data to its default state.
+   * @brief Advances the model through simulated ticks without sleeping.
+   *
+   * @param actions The action for each tick, missing ones are NO_ACT.
+   * @param ticks The number of ticks to simulate.
    */
-  void setModelToDefault() { model_->setDefault(); }
+  void step(const std::vector<UserAction> &actions, size_t ticks) {
+    model_->step(actions, ticks);
+  }
+
+  /**
+   * @brief Resets the model data to its default state. Actions still queued
+   * from the previous game are dropped.
+   */
+  void setModelToDefault() {
+    drainInput();
+    model_->setDefault();
+  }
 
   /**
    * @brief Returns the current game data from the model.
@@ -49,8 +66,129 @@ class Controller {
    */
   typename Model::GameData &getModelData() { return model_->getModelData(); }
 
+  /**
+   * @brief Returns the width of the model's game field.
+   *
+   * @return The number of columns.
+   */
+  int getFieldWidth() const { return model_->getFieldWidth(); }
+
+  /**
+   * @brief Returns the height of the model's game field.
+   *
+   * @return The number of rows.
+   */
+  int getFieldHeight() const { return model_->getFieldHeight(); }
+
+  /**
+   * @brief Returns the current version of the model data.
+   *
+   * @return The latest version stamped by the model.
+   */
+  unsigned long long getModelVersion() const { return model_->getVersion(); }
+
+  /**
+   * @brief Returns the parts of the model data changed after a version.
+   *
+   * @param version The version the caller has already seen.
+   * @return The mask of changed components.
+   */
+  unsigned getModelChanges(unsigned long long version) const {
+    return model_->changedSince(version);
+  }
+
+  /**
+   * @brief Collects the cells and HUD items the model changed since the
+   * previous call.
+   *
+   * @return Reference to the change log, valid until the next call.
+   */
+  const ChangeLog &drainModelChanges() { return model_->drainChanges(); }
+
+  /**
+   * @brief Returns the time left until the model next changes on its own.
+   *
+   * @return The milliseconds to wait, or Model::kNoDeadline while the model
+   * waits for input only.
+   */
+  long long getTimeToDeadline() const { return model_->getTimeToDeadline(); }
+
+  /**
+   * @brief Starts ticking the model on its own thread. Until the thread is
+   * stopped the model may only be reached through postAction() and
+   * getSnapshot().
+   */
+  void startSimulation() {
+    posted_ = 0;
+    simulation_.start();
+  }
+
+  /**
+   * @brief Stops the simulation thread and hands the model back. Actions the
+   * thread did not take in any more are dropped.
+   */
+  void stopSimulation() {
+    simulation_.stop();
+    drainInput();
+  }
+
+  /**
+   * @brief Checks whether the model ticks on its own thread.
+   *
+   * @return true if the simulation thread runs; false otherwise.
+   */
+  bool isSimulating() const { return simulation_.isRunning(); }
+
+  /**
+   * @brief Queues a user action for the next tick, stamped with the time of
+   * the steady clock. Actions past the capacity of the queue are dropped.
+   *
+   * @param action The user action to be performed.
+   */
+  void postAction(UserAction action) {
+    if (input_.push({action, SteadyClock::instance().now()})) ++posted_;
+  }
+
+  /**
+   * @brief Checks whether the simulation thread applied every action posted
+   * since it started, so that the next snapshot shows all of them.
+   *
+   * @return true if no posted action is pending; false otherwise.
+   */
+  bool isInputApplied() const { return simulation_.getApplied() >= posted_; }
+
+  /**
+   * @brief Ticks the model once, applying every queued action at the time
+   * it was performed.
+   */
+  void applyInput() { model_->applyInput(input_); }
+
+  /**
+   * @brief Returns the latest game data published by the simulation thread.
+   *
+   * @return Reference to the snapshot, valid until the next call.
+   */
+  const typename SimulationThread<Model>::Snapshot &getSnapshot() {
+    return simulation_.latest();
+  }
+
  private:
-  Model *model_;  ///< Pointer to the model object being controlled.
+  Model *model_;      ///< Pointer to the model object being controlled.
+  InputQueue input_;  ///< Events queued by the view for the next tick.
+  size_t posted_{};   ///< Actions queued since the simulation started.
+
+  /// Ticks the model on its own thread in the threaded mode.
+  SimulationThread<Model> simulation_;
+
+  /**
+   * @brief Drops every queued action. The caller must be the only consumer
+   * of the queue, so the simulation thread must not run.
+   */
+  void drainInput() {
+    InputEvent event;
+    while (input_.pop(event)) {
+    }
+  }
 };
 
 }  // namespace s21
@@ -0,0 +1,142 @@
+#ifndef BRICKGAME_SIMULATION_THREAD_H_
+#define BRICKGAME_SIMULATION_THREAD_H_
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "../brick_game/base/BaseModel.h"
+#include "../brick_game/base/TripleBuffer.h"
+
+namespace s21 {
+
+/**
+ * @brief Ticks a model on a thread of its own and publishes snapshots of
+ * its game data.
+ *
+ * The thread updates the model every ConstSizes::tick_ms, whatever the view
+ * is doing, and copies the game data out through a triple buffer whenever
+ * the model version changes. Every tick drains the input queue fully. A
+ * view picks up the latest snapshot without waiting, so a slow terminal or
+ * a heavy paint never delays gravity or input. While the thread runs only
+ * it may touch the model and consume the queue.
+ *
+ * @tparam Model The type of the model.
+ */
+template <class Model>
+class SimulationThread {
+ public:
+  /**
+   * @brief Game data published by the thread.
+   */
+  struct Snapshot {
+    typename Model::GameData data;       ///< Copy of the game data
+    BaseModel::Version version{};        ///< Model version of the copy
+    BaseModel::Version field_version{};  ///< Version of the field in it
+  };
+
+  /**
+   * @brief Constructs a stopped thread.
+   *
+   * @param model Pointer to the model to tick.
+   * @param input Pointer to the queue of user actions for the model.
+   */
+  SimulationThread(Model *model, InputQueue *input)
+      : model_(model), input_(input) {}
+
+  SimulationThread(const SimulationThread &) = delete;
+  SimulationThread &operator=(const SimulationThread &) = delete;
+
+  /**
+   * @brief Stops the thread.
+   */
+  ~SimulationThread() { stop(); }
+
+  /**
+   * @brief Starts ticking the model. The current game data is the first
+   * snapshot.
+   */
+  void start() {
+    if (thread_.joinable()) return;
+    applied_.store(0, std::memory_order_relaxed);
+    published_ = model_->getVersion();
+    snapshots_.reset(Snapshot{model_->getModelData(), published_,
+                              model_->getVersion(ModelComponent::FIELD)});
+    running_.store(true, std::memory_order_relaxed);
+    thread_ = std::thread(&SimulationThread::run, this);
+  }
+
+  /**
+   * @brief Stops ticking the model and waits for the thread to finish.
+   */
+  void stop() {
+    running_.store(false, std::memory_order_relaxed);
+    if (thread_.joinable()) thread_.join();
+  }
+
+  /**
+   * @brief Checks whether the thread was started and not stopped yet.
+   *
+   * @return true if the thread owns the model; false otherwise.
+   */
+  bool isRunning() const { return thread_.joinable(); }
+
+  /**
+   * @brief Gets the latest published snapshot. Only one thread may read.
+   *
+   * @return Reference to the snapshot, valid until the next call.
+   */
+  const Snapshot &latest() {
+    snapshots_.update();
+    return snapshots_.front();
+  }
+
+  /**
+   * @brief Gets the number of actions the thread took in since it started
+   * whose tick is over. The snapshot picked up by the next latest() shows
+   * their effect.
+   *
+   * @return The number of actions.
+   */
+  size_t getApplied() const { return applied_.load(std::memory_order_acquire); }
+
+ private:
+  Model *model_;                      ///< The model being ticked
+  std::thread thread_;                ///< The simulation thread
+  std::atomic<bool> running_{};       ///< Cleared to stop the thread
+  InputQueue *input_;                 ///< Actions for the next tick
+  BaseModel::Version published_{};    ///< Version of the last snapshot
+  TripleBuffer<Snapshot> snapshots_;  ///< Snapshots for the view
+  std::atomic<size_t> applied_{};     ///< Actions of the finished ticks
+
+  /**
+   * @brief Ticks the model until stopped or the game is over.
+   */
+  void run() {
+    auto deadline = std::chrono::steady_clock::now();
+    size_t applied = 0;
+    bool over = false;
+    while (!over && running_.load(std::memory_order_relaxed)) {
+      deadline += std::chrono::milliseconds(ConstSizes::tick_ms);
+      std::this_thread::sleep_until(deadline);
+      applied += model_->applyInput(*input_);
+      if (model_->getVersion() != published_) {
+        published_ = model_->getVersion();
+        Snapshot &snapshot = snapshots_.back();
+        snapshot.data = model_->getModelData();
+        snapshot.version = published_;
+        snapshot.field_version = model_->getVersion(ModelComponent::FIELD);
+        snapshots_.publish();
+
+        const GameState state = snapshot.data.game_state;
+        over = state == GameState::GAMEOVER || state == GameState::EXIT;
+      }
+      /* published after the snapshot, so a reader seeing the count sees it */
+      applied_.store(applied, std::memory_order_release);
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_SIMULATION_THREAD_H_
@@ -1,38 +1,21 @@
 #include "ConsoleView.h"
 namespace s21 {
 
-ConsoleView::ConsoleView(SnakeController *s_c, TetrisController *t_c)
-    : snake_view_(s_c), tetris_view_(t_c) {}
-
-void ConsoleView::initNcurses() {
-  initscr();
-  cbreak();
-  noecho();
-  keypad(stdscr, TRUE);
-  nodelay(stdscr, TRUE);
-  curs_set(0);
-
-  start_color();
-  initColors();
-}
-
-void ConsoleView::initColors() {
-  init_color(COLOR_WHITE + 1, 500, 500, 500); /* Gray */
-  init_color(COLOR_WHITE + 2, 1000, 500, 0);  /* Orange */
-
-  init_pair(1, COLOR_RED, COLOR_RED);
-  init_pair(2, COLOR_GREEN, COLOR_GREEN);
-  init_pair(3, COLOR_CYAN, COLOR_CYAN);
-  init_pair(4, COLOR_MAGENTA, COLOR_MAGENTA);
-  init_pair(5, COLOR_YELLOW, COLOR_YELLOW);
-  init_pair(6, COLOR_WHITE + 2, COLOR_WHITE + 2);
-  init_pair(7, COLOR_BLUE, COLOR_BLUE);
-  init_pair(8, COLOR_WHITE + 1, COLOR_WHITE + 1);
+ConsoleView::ConsoleView(SnakeController *s_c, TetrisController *t_c,
+                         bool threaded, ConsoleBackend *backend)
+    : snake_view_(s_c), tetris_view_(t_c) {
+  if (backend == nullptr) backend = &ncurses_;
+  setBackend(backend);
+  setFieldSize(ConstSizes::field_width, ConstSizes::field_height);
+  snake_view_.setBackend(backend);
+  tetris_view_.setBackend(backend);
+  snake_view_.setThreaded(threaded);
+  tetris_view_.setThreaded(threaded);
 }
 
 void ConsoleView::Start() {
   setlocale(LC_ALL, "");
-  initNcurses();
+  backend_->init();
   mainLoop();
 }
 
@@ -51,8 +34,7 @@ void ConsoleView::mainLoop() {
     }
     c = initMenu();
   }
-  curs_set(1);
-  endwin();
+  backend_->shutdown();
 }
 
 }  // namespace s21
\ No newline at end of file
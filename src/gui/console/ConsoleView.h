@@ -1,9 +1,8 @@
 #ifndef BRICK_GAME_CONSOLE_VIEW_H_
 #define BRICK_GAME_CONSOLE_VIEW_H_
 
-#include <ncurses.h>
-
 #include "base/BaseConsoleView.h"
+#include "base/NcursesBackend.h"
 #include "snake/SnakeConsoleView.h"
 #include "tetris/TetrisConsoleView.h"
 
@@ -23,9 +22,13 @@ class ConsoleView : public BaseConsoleView {
    *
    * @param s_c Pointer to the SnakeController object. Defaults to nullptr.
    * @param t_c Pointer to the TetrisController object. Defaults to nullptr.
+   * @param threaded Whether the games tick on the simulation thread.
+   * @param backend The terminal backend to draw on. Defaults to nullptr,
+   * which selects ncurses.
    */
   explicit ConsoleView(SnakeController *s_c = nullptr,
-                       TetrisController *t_c = nullptr);
+                       TetrisController *t_c = nullptr, bool threaded = false,
+                       ConsoleBackend *backend = nullptr);
 
   /**
    * @brief Default destructor.
@@ -39,25 +42,15 @@ class ConsoleView : public BaseConsoleView {
    */
   void Start() override;
 
- protected:
-  /**
-   * @brief Initializes the ncurses library for console rendering.
-   */
-  void initNcurses();
-
  private:
   /**
    * @brief Main loop for managing the console view and game interaction.
    */
   void mainLoop();
 
+  NcursesBackend ncurses_;         ///< Backend used when none is given.
   SnakeConsoleView snake_view_;    ///< Console view for the Snake game.
   TetrisConsoleView tetris_view_;  ///< Console view for the Tetris game.
-
-  /**
-   * @brief Initializes color pairs for ncurses.
-   */
-  static void initColors();
 };
 
 }  // namespace s21
@@ -0,0 +1,262 @@
+#include "AnsiBackend.h"
+
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+namespace s21 {
+
+namespace {
+
+constexpr char kEnterScreen[] = "\x1b[?1049h\x1b[?25l\x1b[2J";
+constexpr char kLeaveScreen[] = "\x1b[0m\x1b[?25h\x1b[?1049l";
+constexpr char kClearScreen[] = "\x1b[0m\x1b[2J";
+constexpr char kBeginUpdate[] = "\x1b[?2026h";
+constexpr char kEndUpdate[] = "\x1b[0m\x1b[?2026l";
+
+/// 256-color palette entries of the color pairs 1 to 8, as in ncurses
+constexpr int kPalette[] = {0, 1, 2, 6, 5, 3, 208, 4, 244};
+
+/// Milliseconds to wait for the rest of a split escape sequence, as ESCDELAY
+constexpr int kEscapeDelay = 25;
+
+/// Signals that would end the program with the terminal left in raw mode
+constexpr int kSignals[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT};
+
+/* the terminal is one per process, so is what the handlers restore */
+termios saved_mode{};                   ///< Terminal mode before init()
+volatile std::sig_atomic_t raw_mode{};  ///< Whether init() changed the mode
+volatile std::sig_atomic_t held{};      ///< Whether the screen is switched
+struct sigaction saved_actions[std::size(kSignals)]{};  ///< Prior handlers
+bool exit_hooked{};  ///< Whether restoreTerminal() runs at exit
+
+}  // namespace
+
+void AnsiBackend::init() {
+  raw_mode = 0;
+  if (tcgetattr(STDIN_FILENO, &saved_mode) == 0) {
+    termios raw = saved_mode;
+    /* like cbreak(): keys arrive one by one, signals and CR to NL stay */
+    raw.c_lflag &= ~(ICANON | ECHO | IEXTEN);
+    raw.c_iflag &= ~(IXON);
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+    raw_mode = tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw) == 0;
+  }
+  in_begin_ = in_end_ = 0;
+  held = 1;
+
+  if (!exit_hooked) exit_hooked = std::atexit(restoreTerminal) == 0;
+  struct sigaction action {};
+  action.sa_handler = onSignal;
+  sigemptyset(&action.sa_mask);
+  for (size_t i = 0; i < std::size(kSignals); ++i) {
+    sigaction(kSignals[i], nullptr, &saved_actions[i]);
+    /* a signal ignored by the parent, as under nohup, stays ignored */
+    if (saved_actions[i].sa_handler != SIG_IGN) {
+      sigaction(kSignals[i], &action, nullptr);
+    }
+  }
+  writeAll(kEnterScreen, sizeof(kEnterScreen) - 1);
+}
+
+void AnsiBackend::shutdown() {
+  restoreTerminal();
+  for (size_t i = 0; i < std::size(kSignals); ++i) {
+    sigaction(kSignals[i], &saved_actions[i], nullptr);
+  }
+}
+
+void AnsiBackend::clear() { writeAll(kClearScreen, sizeof(kClearScreen) - 1); }
+
+void AnsiBackend::present(ConsoleFrame& frame) {
+  const std::string& bytes = encode(frame);
+  if (!bytes.empty()) writeAll(bytes.data(), bytes.size());
+}
+
+const std::string& AnsiBackend::encode(ConsoleFrame& frame) {
+  const size_t capacity =
+      static_cast<size_t>(frame.width()) * frame.height() * kBytesPerCell;
+  if (out_.capacity() < capacity) out_.reserve(capacity);
+  out_.clear();
+
+  const auto& runs = frame.diff();
+  if (runs.empty()) return out_;
+
+  out_ += kBeginUpdate;
+  short color = -1;
+  int cursor_y = -1;
+  int cursor_x = -1;
+  for (const ConsoleRun& run : runs) {
+    if (run.y != cursor_y || run.x != cursor_x) {
+      out_ += "\x1b[";
+      appendNumber(run.y + 1);
+      out_ += ';';
+      appendNumber(run.x + 1);
+      out_ += 'H';
+    }
+    if (run.color != color) {
+      color = run.color;
+      appendColor(color);
+    }
+    for (int x = run.x; x < run.x + run.length; ++x) {
+      appendGlyph(frame.at(run.y, x).glyph);
+    }
+    cursor_y = run.y;
+    cursor_x = run.x + run.length;
+  }
+  out_ += kEndUpdate;
+  return out_;
+}
+
+int AnsiBackend::readKey(bool wait) {
+  while (true) {
+    if (in_begin_ == in_end_) {
+      in_begin_ = in_end_ = 0;
+      if (!readInput(wait ? -1 : 0)) return ConsoleKey::kNone;
+    }
+
+    const size_t size = in_end_ - in_begin_;
+    if (size < sizeof(in_) && isPartialKey(in_ + in_begin_, size)) {
+      /* an arrow split across two reads: give its tail a moment to come */
+      std::memmove(in_, in_ + in_begin_, size);
+      in_begin_ = 0;
+      in_end_ = size;
+      if (readInput(kEscapeDelay)) continue;
+    }
+
+    size_t used = 1;
+    const int key = decodeKey(in_ + in_begin_, size, used);
+    in_begin_ += used;
+    if (key != ConsoleKey::kNone) return key;
+  }
+}
+
+bool AnsiBackend::readInput(int timeout) {
+  if (timeout != 0) {
+    pollfd fd = {STDIN_FILENO, POLLIN, 0};
+    if (poll(&fd, 1, timeout) <= 0) return false;
+  }
+  const ssize_t size =
+      read(STDIN_FILENO, in_ + in_end_, sizeof(in_) - in_end_);
+  if (size <= 0) return false;
+  in_end_ += static_cast<size_t>(size);
+  return true;
+}
+
+int AnsiBackend::decodeKey(const char* bytes, size_t size, size_t& used) {
+  used = 1;
+  if (bytes[0] != '\x1b') return static_cast<unsigned char>(bytes[0]);
+  /* a lone escape is the Esc key, "ESC [ A" or "ESC O A" an arrow */
+  if (size < 3 || (bytes[1] != '[' && bytes[1] != 'O')) return 27;
+
+  /* skip the parameters up to the final byte of the sequence */
+  size_t end = 2;
+  while (end < size && (bytes[end] < 0x40 || bytes[end] > 0x7e)) ++end;
+  if (end == size) return 27;
+  used = end + 1;
+  switch (bytes[end]) {
+    case 'A':
+      return ConsoleKey::kUp;
+    case 'B':
+      return ConsoleKey::kDown;
+    case 'C':
+      return ConsoleKey::kRight;
+    case 'D':
+      return ConsoleKey::kLeft;
+    default:
+      return ConsoleKey::kNone;
+  }
+}
+
+bool AnsiBackend::isPartialKey(const char* bytes, size_t size) {
+  if (size == 0 || bytes[0] != '\x1b') return false;
+  if (size == 1) return true;
+  if (bytes[1] != '[' && bytes[1] != 'O') return false;
+  for (size_t end = 2; end < size; ++end) {
+    if (bytes[end] >= 0x40 && bytes[end] <= 0x7e) return false;
+  }
+  return true;
+}
+
+void AnsiBackend::writeAll(const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t written = write(STDOUT_FILENO, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+}
+
+void AnsiBackend::restoreTerminal() {
+  if (!held) return;
+  held = 0;
+  writeAll(kLeaveScreen, sizeof(kLeaveScreen) - 1);
+  if (raw_mode) tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_mode);
+  raw_mode = 0;
+}
+
+void AnsiBackend::onSignal(int signal) {
+  const int saved_errno = errno;
+  restoreTerminal();
+  for (size_t i = 0; i < std::size(kSignals); ++i) {
+    if (kSignals[i] == signal) sigaction(signal, &saved_actions[i], nullptr);
+  }
+  /* blocked until this handler returns, then taken by the prior handler */
+  std::raise(signal);
+  errno = saved_errno;
+}
+
+void AnsiBackend::appendNumber(int value) {
+  char digits[12];
+  int count = 0;
+  do {
+    digits[count++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  while (count > 0) out_ += digits[--count];
+}
+
+void AnsiBackend::appendGlyph(char32_t glyph) {
+  if (glyph < 0x80) {
+    out_ += static_cast<char>(glyph);
+  } else if (glyph < 0x800) {
+    out_ += static_cast<char>(0xc0 | (glyph >> 6));
+    out_ += static_cast<char>(0x80 | (glyph & 0x3f));
+  } else if (glyph < 0x10000) {
+    out_ += static_cast<char>(0xe0 | (glyph >> 12));
+    out_ += static_cast<char>(0x80 | ((glyph >> 6) & 0x3f));
+    out_ += static_cast<char>(0x80 | (glyph & 0x3f));
+  } else {
+    out_ += static_cast<char>(0xf0 | (glyph >> 18));
+    out_ += static_cast<char>(0x80 | ((glyph >> 12) & 0x3f));
+    out_ += static_cast<char>(0x80 | ((glyph >> 6) & 0x3f));
+    out_ += static_cast<char>(0x80 | (glyph & 0x3f));
+  }
+}
+
+void AnsiBackend::appendColor(short color) {
+  if (color == ConsoleColor::kReverse) {
+    out_ += "\x1b[0;7m";
+  } else if (color <= ConsoleColor::kDefault || color > 8) {
+    out_ += "\x1b[0m";
+  } else {
+    /* the game pairs paint the glyph in the color of the cell */
+    out_ += "\x1b[38;5;";
+    appendNumber(kPalette[color]);
+    out_ += ";48;5;";
+    appendNumber(kPalette[color]);
+    out_ += 'm';
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,140 @@
+#ifndef BRICKGAME_ANSI_BACKEND_H_
+#define BRICKGAME_ANSI_BACKEND_H_
+
+#include <cstddef>
+#include <string>
+
+#include "ConsoleBackend.h"
+
+namespace s21 {
+
+/**
+ * @brief Console backend writing raw ANSI escape sequences.
+ *
+ * Each frame is encoded into one preallocated buffer, wrapped in a
+ * synchronized update so that the terminal shows it at once, and flushed
+ * with a single write(). The cursor is only moved where a run does not
+ * continue the previous one, and the colors only change between runs of
+ * different color pairs, so the cost of a frame follows the number of
+ * changed cells. Keys are read from stdin in raw termios mode; while the
+ * backend holds the terminal, a SIGINT, SIGTERM, SIGHUP, SIGQUIT or exit()
+ * restores it before the program ends.
+ */
+class AnsiBackend : public ConsoleBackend {
+ public:
+  /// @brief Bytes reserved per frame cell: a cursor move, a color and a
+  /// UTF-8 glyph.
+  static constexpr size_t kBytesPerCell = 40;
+
+  /**
+   * @brief Puts stdin in raw mode and switches to the alternate screen.
+   */
+  void init() override;
+
+  /**
+   * @brief Restores the terminal mode and the main screen.
+   */
+  void shutdown() override;
+
+  void clear() override;
+
+  /**
+   * @brief Encodes the changed runs of a frame and writes them out.
+   *
+   * @param frame The frame to show.
+   */
+  void present(ConsoleFrame& frame) override;
+
+  int readKey(bool wait) override;
+
+  /**
+   * @brief Encodes the changed runs of a frame without writing them.
+   *
+   * @param frame The frame to encode.
+   * @return The bytes of the frame, empty if nothing changed; valid until
+   * the next call.
+   */
+  const std::string& encode(ConsoleFrame& frame);
+
+  /**
+   * @brief Decodes the first key of a byte sequence read from the terminal.
+   *
+   * @param bytes The bytes read.
+   * @param size The number of bytes.
+   * @param used Receives the number of bytes the key took, at least 1.
+   * @return The key code, ConsoleKey::kNone for a sequence that is no key.
+   */
+  static int decodeKey(const char* bytes, size_t size, size_t& used);
+
+  /**
+   * @brief Tells whether a byte sequence starts with an escape sequence
+   * whose final byte has not been read yet.
+   *
+   * @param bytes The bytes read.
+   * @param size The number of bytes.
+   * @return True for a lone ESC, "ESC [" or "ESC O" without a final byte.
+   */
+  static bool isPartialKey(const char* bytes, size_t size);
+
+ private:
+  std::string out_;    ///< Bytes of the frame being written
+  char in_[64]{};      ///< Bytes read but not decoded yet
+  size_t in_begin_{};  ///< First undecoded byte of in_
+  size_t in_end_{};    ///< End of the bytes read into in_
+
+  /**
+   * @brief Writes a byte sequence to stdout, retrying after short writes.
+   *
+   * @param data The bytes.
+   * @param size The number of bytes.
+   */
+  static void writeAll(const char* data, size_t size);
+
+  /**
+   * @brief Appends the bytes available on stdin to in_.
+   *
+   * @param timeout Milliseconds to wait for a byte, -1 to block, 0 to read
+   * only what is already there.
+   * @return True if any byte was read.
+   */
+  bool readInput(int timeout);
+
+  /**
+   * @brief Leaves the alternate screen and restores the terminal mode saved
+   * by init(), once; async-signal-safe.
+   */
+  static void restoreTerminal();
+
+  /**
+   * @brief Restores the terminal, then delivers the signal again with the
+   * handler that was installed before init().
+   *
+   * @param signal The signal caught.
+   */
+  static void onSignal(int signal);
+
+  /**
+   * @brief Appends a decimal number to the frame.
+   *
+   * @param value The number, not negative.
+   */
+  void appendNumber(int value);
+
+  /**
+   * @brief Appends a code point to the frame in UTF-8.
+   *
+   * @param glyph The code point.
+   */
+  void appendGlyph(char32_t glyph);
+
+  /**
+   * @brief Appends the escape sequence selecting a color pair.
+   *
+   * @param color The color pair.
+   */
+  void appendColor(short color);
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_ANSI_BACKEND_H_
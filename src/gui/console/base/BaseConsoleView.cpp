@@ -1,133 +1,212 @@
 #include "BaseConsoleView.h"
 
+#ifdef __linux__
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
 namespace s21 {
 
+BaseConsoleView::~BaseConsoleView() {
+#ifdef __linux__
+  if (timer_fd_ >= 0) close(timer_fd_);
+#endif
+}
+
 void BaseConsoleView::drawWindow(const Cords& topLeft,
                                  const Cords& bottomRight) {
-  for (int i = topLeft.y_; i <= bottomRight.y_; ++i) {
-    mvaddch(i, topLeft.x_, ACS_VLINE);
-    mvaddch(i, bottomRight.x_, ACS_VLINE);
+  frame_.box(topLeft, bottomRight);
+}
+
+void BaseConsoleView::renderGameField(WidgetChoice widget, int lvl, int score,
+                                      int best_score) {
+  if (!chrome_drawn_) {
+    drawChrome(widget);
+    chrome_drawn_ = true;
   }
-  for (int i = topLeft.x_; i <= bottomRight.x_; ++i) {
-    mvaddch(topLeft.y_, i, ACS_HLINE);
-    mvaddch(bottomRight.y_, i, ACS_HLINE);
+
+  int side_panel_h = 1;
+  if (widget == WidgetChoice::TETRIS) {
+    side_panel_h = ConstSizes::console_info_panel_h + 1;
   }
 
-  mvaddch(topLeft.y_, topLeft.x_, ACS_ULCORNER);
-  mvaddch(topLeft.y_, bottomRight.x_, ACS_URCORNER);
-  mvaddch(bottomRight.y_, topLeft.x_, ACS_LLCORNER);
-  mvaddch(bottomRight.y_, bottomRight.x_, ACS_LRCORNER);
+  printPanelValue(side_panel_h + 1, field_w_ + 8, std::to_string(lvl));
+  const std::string score_str = std::to_string(score);
+  printPanelValue(side_panel_h + 4,
+                  field_w_ + 9 - static_cast<int>(score_str.length()),
+                  score_str);
+  const std::string best_str = std::to_string(best_score);
+  printPanelValue(side_panel_h + 7,
+                  field_w_ + 9 - static_cast<int>(best_str.length()), best_str);
 }
 
-void BaseConsoleView::renderGameField(WidgetChoice widget, int lvl, int score,
-                                      int best_score) {
+void BaseConsoleView::drawChrome(WidgetChoice widget) {
+  frame_.clear({0, 0}, {windowWidth(), windowHeight()});
   /* main border */
-  drawWindow({0, 0},
-             {ConstSizes::console_window_w, ConstSizes::console_window_h});
+  frame_.box({0, 0}, {windowWidth(), windowHeight()});
   /* field border */
-  drawWindow({0, 0},
-             {ConstSizes::field_width + 1, ConstSizes::field_height + 1});
+  frame_.box({0, 0}, {field_w_ + 1, field_h_ + 1});
 
-  mvaddch(0, ConstSizes::field_width + 1, ACS_TTEE);
-  mvaddch(ConstSizes::field_height + 1, ConstSizes::field_width + 1, ACS_BTEE);
+  frame_.put(0, field_w_ + 1, ConsoleGlyph::kTTee);
+  frame_.put(field_h_ + 1, field_w_ + 1, ConsoleGlyph::kBTee);
 
   int side_panel_h = 1;
   if (widget == WidgetChoice::TETRIS) {
     side_panel_h = ConstSizes::console_info_panel_h;
 
-    drawWindow({ConstSizes::field_width + 2, 1},
-               {ConstSizes::console_window_w - 1, side_panel_h});
-    mvprintw(1, ConstSizes::field_width + 3, "Next");
+    frame_.box({field_w_ + 2, 1}, {windowWidth() - 1, side_panel_h});
+    frame_.print(1, field_w_ + 3, "Next");
     side_panel_h += 1;
   }
 
-  drawWindow({ConstSizes::field_width + 2, side_panel_h},
-             {ConstSizes::console_window_w - 1, side_panel_h + 2});
-  mvprintw(side_panel_h, ConstSizes::field_width + 3, "Level");
-  mvprintw(side_panel_h + 1, ConstSizes::field_width + 8, "%d", lvl);
+  frame_.box({field_w_ + 2, side_panel_h},
+             {windowWidth() - 1, side_panel_h + 2});
+  frame_.print(side_panel_h, field_w_ + 3, "Level");
   side_panel_h += 3;
 
-  drawWindow({ConstSizes::field_width + 2, side_panel_h},
-             {ConstSizes::console_window_w - 1, side_panel_h + 2});
-  mvprintw(side_panel_h, ConstSizes::field_width + 3, "Score");
-  int score_len = static_cast<int>(std::to_string(score).length());
-  mvprintw(side_panel_h + 1, ConstSizes::field_width + 9 - score_len, "%d",
-           score);
+  frame_.box({field_w_ + 2, side_panel_h},
+             {windowWidth() - 1, side_panel_h + 2});
+  frame_.print(side_panel_h, field_w_ + 3, "Score");
   side_panel_h += 3;
 
-  drawWindow({ConstSizes::field_width + 2, side_panel_h},
-             {ConstSizes::console_window_w - 1, side_panel_h + 2});
-  mvprintw(side_panel_h, ConstSizes::field_width + 3, "Best");
-  int b_score_len = static_cast<int>(std::to_string(best_score).length());
-  mvprintw(side_panel_h + 1, ConstSizes::field_width + 9 - b_score_len, "%d",
-           best_score);
+  frame_.box({field_w_ + 2, side_panel_h},
+             {windowWidth() - 1, side_panel_h + 2});
+  frame_.print(side_panel_h, field_w_ + 3, "Best");
+}
+
+void BaseConsoleView::printPanelValue(int y, int x, const std::string& text) {
+  frame_.clear({field_w_ + 3, y}, {windowWidth() - 2, y});
+  frame_.print(y, x, text);
+}
+
+void BaseConsoleView::presentFrame() { backend_->present(frame_); }
+
+void BaseConsoleView::eraseScreen() {
+  backend_->clear();
+  frame_.forget();
+}
+
+void BaseConsoleView::beginScreen() {
+  frame_.clear({0, 0}, {windowWidth(), windowHeight()});
+  drawWindow({0, 0}, {windowWidth(), windowHeight()});
+  chrome_drawn_ = false;
 }
 
 void BaseConsoleView::renderGameOverMenu(bool win, int lvl, int score,
                                          int best_score) {
-  clear();
-  drawWindow({0, 0},
-             {ConstSizes::console_window_w, ConstSizes::console_window_h});
+  beginScreen();
 
   if (win) {
-    mvprintw(2, ConstSizes::console_window_w / 2 - 4, "VICTORY");
+    frame_.print(2, windowWidth() / 2 - 4, "VICTORY");
   } else {
-    mvprintw(2, ConstSizes::console_window_w / 2 - 4, "GAMEOVER");
+    frame_.print(2, windowWidth() / 2 - 4, "GAMEOVER");
   }
 
-  mvprintw(4, ConstSizes::console_window_w / 2 - 4, "Score: %d", score);
-  mvprintw(6, ConstSizes::console_window_w / 2 - 4, "Level: %d", lvl);
-  mvprintw(8, ConstSizes::console_window_w / 2 - 7, "Best score: %d",
-           best_score);
+  frame_.print(4, windowWidth() / 2 - 4, "Score: " + std::to_string(score));
+  frame_.print(6, windowWidth() / 2 - 4, "Level: " + std::to_string(lvl));
+  frame_.print(8, windowWidth() / 2 - 7,
+               "Best score: " + std::to_string(best_score));
 
-  mvprintw(10, ConstSizes::console_window_w / 2 - 5, "Press any key");
-  mvprintw(11, ConstSizes::console_window_w / 2 - 5, "to continue");
-  nodelay(stdscr, FALSE);
-  getch();
+  frame_.print(10, windowWidth() / 2 - 5, "Press any key");
+  frame_.print(11, windowWidth() / 2 - 5, "to continue");
+  presentFrame();
+  backend_->readKey(true);
 }
 
 void BaseConsoleView::renderPauseInfo(int lvl, int score, int best_score) {
-  clear();
-  drawWindow({0, 0},
-             {ConstSizes::console_window_w, ConstSizes::console_window_h});
+  beginScreen();
 
-  mvprintw(5, ConstSizes::console_window_w / 2 - 10, "The game is on pause");
-  mvprintw(8, ConstSizes::console_window_w / 2 - 7, "Score:  %d", score);
-  mvprintw(10, ConstSizes::console_window_w / 2 - 7, "Level:  %d", lvl);
-  mvprintw(12, ConstSizes::console_window_w / 2 - 7, "Best score:  %d",
-           best_score);
+  frame_.print(5, windowWidth() / 2 - 10, "The game is on pause");
+  frame_.print(8, windowWidth() / 2 - 7, "Score:  " + std::to_string(score));
+  frame_.print(10, windowWidth() / 2 - 7, "Level:  " + std::to_string(lvl));
+  frame_.print(12, windowWidth() / 2 - 7,
+               "Best score:  " + std::to_string(best_score));
 
-  mvprintw(14, ConstSizes::console_window_w / 2 - 10, "Press Tab to continue");
-  mvprintw(15, ConstSizes::console_window_w / 2 - 5, "or Esc to exit");
+  frame_.print(14, windowWidth() / 2 - 10, "Press Tab to continue");
+  frame_.print(15, windowWidth() / 2 - 5, "or Esc to exit");
 
-  nodelay(stdscr, FALSE);
+  presentFrame();
+  wait_for_key_ = true;
 }
 
 void BaseConsoleView::renderStartInfo() {
-  clear();
-  drawWindow({0, 0},
-             {ConstSizes::console_window_w, ConstSizes::console_window_h});
+  beginScreen();
 
-  mvprintw(9, ConstSizes::console_window_w / 2 - 6, "Press space");
-  mvprintw(10, ConstSizes::console_window_w / 2 - 5, "to start");
-  mvprintw(11, ConstSizes::console_window_w / 2 - 7, "or Esc to exit");
-  nodelay(stdscr, FALSE);
+  frame_.print(9, windowWidth() / 2 - 6, "Press space");
+  frame_.print(10, windowWidth() / 2 - 5, "to start");
+  frame_.print(11, windowWidth() / 2 - 7, "or Esc to exit");
+  presentFrame();
+  wait_for_key_ = true;
 }
 
 UserAction BaseConsoleView::getAction() {
+  const UserAction action = keyToAction(backend_->readKey(wait_for_key_));
+  wait_for_key_ = false;
+  return action;
+}
+
+const std::vector<UserAction>& BaseConsoleView::readActions() {
+  actions_.clear();
+  /* the start and pause screens wait for the first key */
+  for (int key = backend_->readKey(wait_for_key_); key != ConsoleKey::kNone;
+       key = backend_->readKey(false)) {
+    wait_for_key_ = false;
+    const UserAction action = keyToAction(key);
+    if (action != UserAction::NO_ACT) actions_.push_back(action);
+  }
+  wait_for_key_ = false;
+  return actions_;
+}
+
+void BaseConsoleView::waitForInput(long long timeout_ms) {
+  if (timeout_ms <= 0) return;
+#ifdef __linux__
+  if (timer_fd_ < 0) {
+    timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+  }
+  const bool timed = timeout_ms != BaseModel::kNoDeadline;
+  pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {timer_fd_, POLLIN, 0}};
+  int poll_timeout = -1;
+
+  if (timer_fd_ >= 0) {
+    /* a zero expiry disarms the timer, so only a key wakes the view */
+    itimerspec spec{};
+    if (timed) {
+      spec.it_value.tv_sec = timeout_ms / 1000;
+      spec.it_value.tv_nsec = timeout_ms % 1000 * 1000000;
+    }
+    timerfd_settime(timer_fd_, 0, &spec, nullptr);
+  } else if (timed) {
+    poll_timeout = static_cast<int>(timeout_ms);
+  }
+
+  poll(fds, timer_fd_ >= 0 ? 2 : 1, poll_timeout);
+  if (fds[1].revents & POLLIN) {
+    uint64_t expirations = 0;
+    const ssize_t size = read(timer_fd_, &expirations, sizeof(expirations));
+    (void)size;
+  }
+#else
+  const long long tick = ConstSizes::tick_ms;
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(std::min(timeout_ms, tick)));
+#endif
+}
+
+UserAction BaseConsoleView::keyToAction(int key) {
   UserAction action = UserAction::NO_ACT;
-  int key = getch();
   switch (key) {
-    case KEY_LEFT:
+    case ConsoleKey::kLeft:
       action = UserAction::LEFT_BTN;
       break;
-    case KEY_RIGHT:
+    case ConsoleKey::kRight:
       action = UserAction::RIGHT_BTN;
       break;
-    case KEY_UP:
+    case ConsoleKey::kUp:
       action = UserAction::UP_BTN;
       break;
-    case KEY_DOWN:
+    case ConsoleKey::kDown:
       action = UserAction::DOWN_BTN;
       break;
     case 13:
@@ -145,7 +224,6 @@ UserAction BaseConsoleView::getAction() {
     default:
       break;
   }
-  nodelay(stdscr, TRUE);
   return action;
 }
 
@@ -153,15 +231,15 @@ WidgetChoice BaseConsoleView::initMenu() {
   WidgetChoice ret_val = WidgetChoice::MENU;
   size_t selectedItem = 0;
 
+  eraseScreen();
   renderMenu(selectedItem);
 
   int ch;
-  nodelay(stdscr, FALSE);
   do {
-    ch = getch();
-    if (ch == KEY_UP && selectedItem > 0) {
+    ch = backend_->readKey(true);
+    if (ch == ConsoleKey::kUp && selectedItem > 0) {
       --selectedItem;
-    } else if (ch == KEY_DOWN && selectedItem < 2) {
+    } else if (ch == ConsoleKey::kDown && selectedItem < 2) {
       ++selectedItem;
     }
     renderMenu(selectedItem);
@@ -183,30 +261,23 @@ WidgetChoice BaseConsoleView::initMenu() {
 }
 
 void BaseConsoleView::renderMenu(size_t& selectedItem) {
-  clear();
+  beginScreen();
 
   int start_y = 10;
-  int start_x = ConstSizes::console_window_w / 2;
+  int start_x = windowWidth() / 2;
 
-  drawWindow({0, 0},
-             {ConstSizes::console_window_w, ConstSizes::console_window_h});
-  mvprintw(start_y - 4, start_x - 4, "BRICKGAME");
+  frame_.print(start_y - 4, start_x - 4, "BRICKGAME");
 
   std::vector<std::string> choices = {"Snake", "Tetris", "Exit"};
 
   for (std::size_t i = 0; i < choices.size(); ++i) {
-    if (i == selectedItem) {
-      attron(A_REVERSE);
-      mvprintw(++start_y + i, start_x - (int)choices[i].length() / 2, "%s",
-               choices[i].c_str());
-      attroff(A_REVERSE);
-    } else {
-      mvprintw(++start_y + i, start_x - (int)choices[i].length() / 2, "%s",
-               choices[i].c_str());
-    }
+    const short color =
+        i == selectedItem ? ConsoleColor::kReverse : ConsoleColor::kDefault;
+    frame_.print(++start_y + i, start_x - (int)choices[i].length() / 2,
+                 choices[i], color);
   }
 
-  refresh();
+  presentFrame();
 }
 
-}  // namespace s21
\ No newline at end of file
+}  // namespace s21
@@ -1,16 +1,17 @@
 #ifndef BRICKGAME_BASE_CONSOLE_VIEW_H_
 #define BRICKGAME_BASE_CONSOLE_VIEW_H_
 
-#include <ncurses.h>
-
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "../../../brick_game/snake/SnakeModel.h"
 #include "../../../brick_game/tetris/TetrisModel.h"
 #include "../../../controller/Controller.h"
+#include "ConsoleBackend.h"
 
 namespace s21 {
 
@@ -21,6 +22,11 @@ enum class WidgetChoice { MENU, EXIT, TETRIS, SNAKE };
  */
 class BaseConsoleView {
  public:
+  /**
+   * @brief Releases the input timer.
+   */
+  virtual ~BaseConsoleView();
+
   /**
    * @brief Pure virtual function to start the console view.
    *
@@ -29,7 +35,7 @@ class BaseConsoleView {
   virtual void Start() = 0;
 
   /**
-   * @brief Draws a window on the console.
+   * @brief Draws a window into the frame of the console.
    *
    * @param topLeft Coordinates of the top-left corner of the window.
    * @param bottomRight Coordinates of the bottom-right corner of the window.
@@ -40,6 +46,9 @@ class BaseConsoleView {
    * @brief Renders the game field for the specified widget with the given level
    * and scores.
    *
+   * The boxes and titles go into the frame once per layout; later calls only
+   * rewrite the values.
+   *
    * @param widget The widget choice representing the current game (e.g., Tetris
    * or Snake).
    * @param lvl The current level of the game.
@@ -79,6 +88,34 @@ class BaseConsoleView {
    */
   UserAction getAction();
 
+  /**
+   * @brief Reads every key waiting in the console input.
+   *
+   * @return The actions of the keys in the order they were pressed, valid
+   * until the next call.
+   */
+  const std::vector<UserAction>& readActions();
+
+  /**
+   * @brief Sleeps until a key is pressed or a timeout expires.
+   *
+   * On Linux the view polls stdin together with a timerfd armed for the
+   * timeout, so it wakes as soon as either is due, and not at all while
+   * there is no timeout. Elsewhere it sleeps for at most one tick.
+   *
+   * @param timeout_ms The longest wait in milliseconds, or
+   * BaseModel::kNoDeadline to wait for a key only.
+   */
+  void waitForInput(long long timeout_ms);
+
+  /**
+   * @brief Maps a key code to the user action it stands for.
+   *
+   * @param key The key code returned by ConsoleBackend::readKey().
+   * @return The user action, UserAction::NO_ACT for other keys.
+   */
+  static UserAction keyToAction(int key);
+
   /**
    * @brief Initializes and displays the main menu.
    *
@@ -92,6 +129,123 @@ class BaseConsoleView {
    * @param selectedItem The index of the currently selected menu item.
    */
   void renderMenu(size_t& selectedItem);
+
+  /**
+   * @brief Chooses whether the model ticks on the simulation thread while
+   * the view only draws its snapshots.
+   *
+   * @param threaded true for the threaded mode; false to tick the model from
+   * the view loop.
+   */
+  void setThreaded(bool threaded) { threaded_ = threaded; }
+
+  /**
+   * @brief Checks whether the view runs the model on the simulation thread.
+   *
+   * @return true in the threaded mode; false otherwise.
+   */
+  bool isThreaded() const { return threaded_; }
+
+  /**
+   * @brief Sets the terminal backend the view draws on and reads keys from.
+   *
+   * @param backend The backend, owned by the caller and set up by it.
+   */
+  void setBackend(ConsoleBackend* backend) { backend_ = backend; }
+
+ protected:
+  int field_w_ = ConstSizes::field_width;   ///< Columns of the game field
+  int field_h_ = ConstSizes::field_height;  ///< Rows of the game field
+  bool threaded_ = false;                   ///< Model on its own thread
+  std::vector<UserAction> actions_;         ///< Keys read by readActions()
+  int timer_fd_ = -1;                       ///< Timer of waitForInput()
+  ConsoleBackend* backend_ = nullptr;       ///< Terminal to draw on
+  ConsoleFrame frame_;                      ///< Shadow buffer of the screen
+  bool chrome_drawn_ = false;               ///< Game boxes in frame_
+  bool wait_for_key_ = false;               ///< Next read blocks for a key
+
+  /**
+   * @brief Lays the view out for a game field of the given size.
+   *
+   * @param width The number of columns of the game field.
+   * @param height The number of rows of the game field.
+   */
+  void setFieldSize(int width, int height) {
+    field_w_ = width;
+    field_h_ = height;
+    frame_.resize(windowWidth() + 1, windowHeight() + 1);
+    chrome_drawn_ = false;
+  }
+
+  /**
+   * @brief Puts a cell of the game field into the frame. Cells outside the
+   * field are dropped so that they never overwrite the borders.
+   *
+   * @param y The row on the game field.
+   * @param x The column on the game field.
+   * @param glyph The code point to show.
+   * @param color The color pair.
+   */
+  void putFieldCell(int y, int x, char32_t glyph, short color) {
+    if (y < 0 || y >= field_h_ || x < 0 || x >= field_w_) return;
+    frame_.put(y + 1, x + 1, glyph, color);
+  }
+
+  /**
+   * @brief Blanks the game field in the frame before drawing a new state.
+   */
+  void clearField() { frame_.clear({1, 1}, {field_w_, field_h_}); }
+
+  /**
+   * @brief Writes the cells of the frame that changed since the last
+   * present to the terminal.
+   */
+  void presentFrame();
+
+  /**
+   * @brief Blanks the terminal when the view takes it over from another
+   * one, so that the next present draws the frame in full.
+   */
+  void eraseScreen();
+
+  /**
+   * @brief Blanks the frame for a text screen and draws its border. The
+   * game boxes are drawn again on the next game frame.
+   */
+  void beginScreen();
+
+  /**
+   * @brief Gets the rightmost column of the console window.
+   *
+   * @return The field width plus the side panel.
+   */
+  int windowWidth() const { return field_w_ + 1 + ConstSizes::console_panel_w; }
+
+  /**
+   * @brief Gets the bottom row of the console window.
+   *
+   * @return The field height, but at least the height of the side panel.
+   */
+  int windowHeight() const {
+    return std::max(field_h_ + 1, ConstSizes::console_window_h);
+  }
+
+ private:
+  /**
+   * @brief Draws the boxes and titles of the game screen into the frame.
+   *
+   * @param widget The game the screen is for.
+   */
+  void drawChrome(WidgetChoice widget);
+
+  /**
+   * @brief Rewrites one value line of the side panel.
+   *
+   * @param y The row of the value.
+   * @param x The column of its first character.
+   * @param text The value.
+   */
+  void printPanelValue(int y, int x, const std::string& text);
 };
 
 }  // namespace s21
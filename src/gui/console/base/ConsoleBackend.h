@@ -0,0 +1,61 @@
+#ifndef BRICKGAME_CONSOLE_BACKEND_H_
+#define BRICKGAME_CONSOLE_BACKEND_H_
+
+#include "ConsoleFrame.h"
+
+namespace s21 {
+
+/**
+ * @brief Key codes the console backends return. Printable and control keys
+ * keep their ASCII codes; the arrows get codes past the byte range.
+ */
+namespace ConsoleKey {
+constexpr int kNone = -1;  ///< No key is waiting
+constexpr int kUp = 0x101;
+constexpr int kDown = 0x102;
+constexpr int kLeft = 0x103;
+constexpr int kRight = 0x104;
+}  // namespace ConsoleKey
+
+/**
+ * @brief Terminal the console views draw their frames on and read keys
+ * from.
+ */
+class ConsoleBackend {
+ public:
+  virtual ~ConsoleBackend() = default;
+
+  /**
+   * @brief Takes over the terminal: raw input, no echo, hidden cursor.
+   */
+  virtual void init() = 0;
+
+  /**
+   * @brief Gives the terminal back in the state init() found it.
+   */
+  virtual void shutdown() = 0;
+
+  /**
+   * @brief Blanks the whole terminal, also outside the frames.
+   */
+  virtual void clear() = 0;
+
+  /**
+   * @brief Writes the cells of a frame that changed since its last diff.
+   *
+   * @param frame The frame to show.
+   */
+  virtual void present(ConsoleFrame& frame) = 0;
+
+  /**
+   * @brief Reads the next key.
+   *
+   * @param wait Whether to block until a key is pressed.
+   * @return The key code, ConsoleKey::kNone if no key is waiting.
+   */
+  virtual int readKey(bool wait) = 0;
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_CONSOLE_BACKEND_H_
@@ -0,0 +1,84 @@
+#include "ConsoleFrame.h"
+
+namespace s21 {
+
+namespace {
+
+/// Front cell that matches no back cell, so that it is always rewritten
+constexpr ConsoleCell kUnknownCell{0, -1};
+
+}  // namespace
+
+void ConsoleFrame::resize(int width, int height) {
+  width_ = width;
+  height_ = height;
+  back_.assign(static_cast<size_t>(width_) * height_, ConsoleCell{});
+  runs_.clear();
+  runs_.reserve(back_.size());
+  forget();
+}
+
+void ConsoleFrame::put(int y, int x, char32_t glyph, short color) {
+  if (y < 0 || y >= height_ || x < 0 || x >= width_) return;
+  back_[y * width_ + x] = {glyph, color};
+}
+
+void ConsoleFrame::print(int y, int x, const std::string& text, short color) {
+  for (char c : text) put(y, x++, static_cast<unsigned char>(c), color);
+}
+
+void ConsoleFrame::clear(const Cords& topLeft, const Cords& bottomRight) {
+  for (int y = topLeft.y_; y <= bottomRight.y_; ++y) {
+    for (int x = topLeft.x_; x <= bottomRight.x_; ++x) {
+      put(y, x, ConsoleGlyph::kBlank);
+    }
+  }
+}
+
+void ConsoleFrame::box(const Cords& topLeft, const Cords& bottomRight) {
+  for (int y = topLeft.y_; y <= bottomRight.y_; ++y) {
+    put(y, topLeft.x_, ConsoleGlyph::kVLine);
+    put(y, bottomRight.x_, ConsoleGlyph::kVLine);
+  }
+  for (int x = topLeft.x_; x <= bottomRight.x_; ++x) {
+    put(topLeft.y_, x, ConsoleGlyph::kHLine);
+    put(bottomRight.y_, x, ConsoleGlyph::kHLine);
+  }
+
+  put(topLeft.y_, topLeft.x_, ConsoleGlyph::kULCorner);
+  put(topLeft.y_, bottomRight.x_, ConsoleGlyph::kURCorner);
+  put(bottomRight.y_, topLeft.x_, ConsoleGlyph::kLLCorner);
+  put(bottomRight.y_, bottomRight.x_, ConsoleGlyph::kLRCorner);
+}
+
+const std::vector<ConsoleRun>& ConsoleFrame::diff() {
+  runs_.clear();
+  for (int y = 0; y < height_; ++y) {
+    const ConsoleCell* back = &back_[y * width_];
+    ConsoleCell* front = &front_[y * width_];
+    int x = 0;
+    while (x < width_) {
+      if (back[x] == front[x]) {
+        ++x;
+        continue;
+      }
+      /* grow the run over its color while the gaps stay short */
+      const short color = back[x].color;
+      int end = x + 1;
+      for (int i = end; i < width_ && back[i].color == color; ++i) {
+        if (back[i] != front[i]) {
+          end = i + 1;
+        } else if (i - end >= kMaxGap) {
+          break;
+        }
+      }
+      runs_.push_back({y, x, end - x, color});
+      for (; x < end; ++x) front[x] = back[x];
+    }
+  }
+  return runs_;
+}
+
+void ConsoleFrame::forget() { front_.assign(back_.size(), kUnknownCell); }
+
+}  // namespace s21
@@ -0,0 +1,166 @@
+#ifndef BRICKGAME_CONSOLE_FRAME_H_
+#define BRICKGAME_CONSOLE_FRAME_H_
+
+#include <string>
+#include <vector>
+
+#include "../../../brick_game/base/BaseConstants.h"
+
+namespace s21 {
+
+/**
+ * @brief Box-drawing glyphs of the console frames, as Unicode code points.
+ * Each backend translates them to what its terminal understands.
+ */
+namespace ConsoleGlyph {
+constexpr char32_t kBlank = U' ';
+constexpr char32_t kHLine = U'\u2500';
+constexpr char32_t kVLine = U'\u2502';
+constexpr char32_t kULCorner = U'\u250c';
+constexpr char32_t kURCorner = U'\u2510';
+constexpr char32_t kLLCorner = U'\u2514';
+constexpr char32_t kLRCorner = U'\u2518';
+constexpr char32_t kTTee = U'\u252c';
+constexpr char32_t kBTee = U'\u2534';
+}  // namespace ConsoleGlyph
+
+/**
+ * @brief Color pairs with a meaning beyond the game colors 1 to 8.
+ */
+namespace ConsoleColor {
+constexpr short kDefault = 0;  ///< Terminal default colors
+constexpr short kReverse = 9;  ///< Default colors swapped, for highlights
+}  // namespace ConsoleColor
+
+/**
+ * @brief One character cell of the console: a glyph and its color pair.
+ */
+struct ConsoleCell {
+  char32_t glyph = ConsoleGlyph::kBlank;  ///< Code point shown in the cell
+  short color = 0;                        ///< Color pair, 0 for the default
+
+  bool operator==(const ConsoleCell& other) const {
+    return glyph == other.glyph && color == other.color;
+  }
+  bool operator!=(const ConsoleCell& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief A horizontal span of cells of one color pair that a backend writes
+ * with a single cursor move and a single attribute change.
+ */
+struct ConsoleRun {
+  int y;        ///< Row of the span
+  int x;        ///< First column of the span
+  int length;   ///< Number of cells in the span
+  short color;  ///< Color pair of every cell in the span
+};
+
+/**
+ * @brief Shadow-buffered console frame.
+ *
+ * The views draw each frame into the back buffer; diff() compares it with
+ * the front buffer, which mirrors what the terminal shows, and returns only
+ * the changed cells as runs of one color. A run also takes in up to kMaxGap
+ * unchanged cells of its color between two changes, since rewriting them is
+ * cheaper than moving the cursor. Cells that do not change, such as the
+ * borders, are therefore sent to the terminal once.
+ */
+class ConsoleFrame {
+ public:
+  /// @brief Longest stretch of unchanged cells a run bridges.
+  static constexpr int kMaxGap = 4;
+
+  /**
+   * @brief Sets the size of the frame, blanks it and forgets the screen.
+   *
+   * @param width The number of columns.
+   * @param height The number of rows.
+   */
+  void resize(int width, int height);
+
+  /**
+   * @brief Gets the number of columns.
+   *
+   * @return The width of the frame.
+   */
+  int width() const { return width_; }
+
+  /**
+   * @brief Gets the number of rows.
+   *
+   * @return The height of the frame.
+   */
+  int height() const { return height_; }
+
+  /**
+   * @brief Gets a cell of the back buffer.
+   *
+   * @param y The row, inside the frame.
+   * @param x The column, inside the frame.
+   * @return The cell.
+   */
+  const ConsoleCell& at(int y, int x) const { return back_[y * width_ + x]; }
+
+  /**
+   * @brief Sets a cell of the back buffer. Cells outside the frame are
+   * ignored.
+   *
+   * @param y The row.
+   * @param x The column.
+   * @param glyph The code point to show.
+   * @param color The color pair.
+   */
+  void put(int y, int x, char32_t glyph, short color = 0);
+
+  /**
+   * @brief Writes ASCII text into the back buffer from a cell rightwards.
+   *
+   * @param y The row.
+   * @param x The column of the first character.
+   * @param text The text.
+   * @param color The color pair.
+   */
+  void print(int y, int x, const std::string& text, short color = 0);
+
+  /**
+   * @brief Blanks a rectangle of the back buffer.
+   *
+   * @param topLeft The top-left cell of the rectangle.
+   * @param bottomRight The bottom-right cell of the rectangle, inclusive.
+   */
+  void clear(const Cords& topLeft, const Cords& bottomRight);
+
+  /**
+   * @brief Draws a box outline into the back buffer.
+   *
+   * @param topLeft The top-left corner.
+   * @param bottomRight The bottom-right corner.
+   */
+  void box(const Cords& topLeft, const Cords& bottomRight);
+
+  /**
+   * @brief Finds the cells changed since the last diff and marks them as
+   * shown.
+   *
+   * @return The runs to write, in row order, valid until the next call.
+   */
+  const std::vector<ConsoleRun>& diff();
+
+  /**
+   * @brief Forgets what the terminal shows, so that the next diff rewrites
+   * every cell. Call after the screen was drawn past the frame.
+   */
+  void forget();
+
+ private:
+  int width_{};                     ///< Columns of the frame
+  int height_{};                    ///< Rows of the frame
+  std::vector<ConsoleCell> back_;   ///< Frame being drawn
+  std::vector<ConsoleCell> front_;  ///< Frame on the terminal
+  std::vector<ConsoleRun> runs_;    ///< Result of the last diff
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_CONSOLE_FRAME_H_
@@ -0,0 +1,96 @@
+#include "NcursesBackend.h"
+
+namespace s21 {
+
+void NcursesBackend::init() {
+  initscr();
+  cbreak();
+  noecho();
+  keypad(stdscr, TRUE);
+  nodelay(stdscr, TRUE);
+  curs_set(0);
+
+  start_color();
+  initColors();
+}
+
+void NcursesBackend::shutdown() {
+  curs_set(1);
+  endwin();
+}
+
+void NcursesBackend::clear() { erase(); }
+
+void NcursesBackend::initColors() {
+  init_color(COLOR_WHITE + 1, 500, 500, 500); /* Gray */
+  init_color(COLOR_WHITE + 2, 1000, 500, 0);  /* Orange */
+
+  init_pair(1, COLOR_RED, COLOR_RED);
+  init_pair(2, COLOR_GREEN, COLOR_GREEN);
+  init_pair(3, COLOR_CYAN, COLOR_CYAN);
+  init_pair(4, COLOR_MAGENTA, COLOR_MAGENTA);
+  init_pair(5, COLOR_YELLOW, COLOR_YELLOW);
+  init_pair(6, COLOR_WHITE + 2, COLOR_WHITE + 2);
+  init_pair(7, COLOR_BLUE, COLOR_BLUE);
+  init_pair(8, COLOR_WHITE + 1, COLOR_WHITE + 1);
+}
+
+void NcursesBackend::present(ConsoleFrame& frame) {
+  short color = -1;
+  for (const ConsoleRun& run : frame.diff()) {
+    if (run.color != color) {
+      color = run.color;
+      attrset(color == ConsoleColor::kReverse ? A_REVERSE : COLOR_PAIR(color));
+    }
+    move(run.y, run.x);
+    for (int x = run.x; x < run.x + run.length; ++x) {
+      addch(glyphToChar(frame.at(run.y, x).glyph));
+    }
+  }
+  attrset(A_NORMAL);
+  refresh();
+}
+
+int NcursesBackend::readKey(bool wait) {
+  nodelay(stdscr, wait ? FALSE : TRUE);
+  const int key = getch();
+  switch (key) {
+    case ERR:
+      return ConsoleKey::kNone;
+    case KEY_UP:
+      return ConsoleKey::kUp;
+    case KEY_DOWN:
+      return ConsoleKey::kDown;
+    case KEY_LEFT:
+      return ConsoleKey::kLeft;
+    case KEY_RIGHT:
+      return ConsoleKey::kRight;
+    default:
+      return key;
+  }
+}
+
+chtype NcursesBackend::glyphToChar(char32_t glyph) {
+  switch (glyph) {
+    case ConsoleGlyph::kHLine:
+      return ACS_HLINE;
+    case ConsoleGlyph::kVLine:
+      return ACS_VLINE;
+    case ConsoleGlyph::kULCorner:
+      return ACS_ULCORNER;
+    case ConsoleGlyph::kURCorner:
+      return ACS_URCORNER;
+    case ConsoleGlyph::kLLCorner:
+      return ACS_LLCORNER;
+    case ConsoleGlyph::kLRCorner:
+      return ACS_LRCORNER;
+    case ConsoleGlyph::kTTee:
+      return ACS_TTEE;
+    case ConsoleGlyph::kBTee:
+      return ACS_BTEE;
+    default:
+      return glyph < 128 ? static_cast<chtype>(glyph) : '?';
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,46 @@
+#ifndef BRICKGAME_NCURSES_BACKEND_H_
+#define BRICKGAME_NCURSES_BACKEND_H_
+
+#include <ncurses.h>
+
+#include "ConsoleBackend.h"
+
+namespace s21 {
+
+/**
+ * @brief Console backend drawing through ncurses.
+ */
+class NcursesBackend : public ConsoleBackend {
+ public:
+  void init() override;
+  void shutdown() override;
+  void clear() override;
+
+  /**
+   * @brief Writes the changed runs of a frame to stdscr and refreshes it.
+   * Runs of one color in a row share a single attribute change.
+   *
+   * @param frame The frame to show.
+   */
+  void present(ConsoleFrame& frame) override;
+
+  int readKey(bool wait) override;
+
+ private:
+  /**
+   * @brief Initializes the color pairs of the games.
+   */
+  static void initColors();
+
+  /**
+   * @brief Maps a frame glyph to the ncurses character that shows it.
+   *
+   * @param glyph The code point.
+   * @return The character, with the line-drawing glyphs mapped to ACS ones.
+   */
+  static chtype glyphToChar(char32_t glyph);
+};
+
+}  // namespace s21
+
+#endif  // BRICKGAME_NCURSES_BACKEND_H_
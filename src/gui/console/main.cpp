@@ -1,18 +1,42 @@
 
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
 #include "ConsoleView.h"
+#include "base/AnsiBackend.h"
 
 using namespace s21;
-int main() {
+int main(int argc, char *argv[]) {
+  /* brick_game_console [--threaded] [--ansi] [WIDTH HEIGHT] */
+  bool threaded = false;
+  bool ansi = false;
+  std::vector<const char *> sizes;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--threaded") == 0) {
+      threaded = true;
+    } else if (std::strcmp(argv[i], "--ansi") == 0) {
+      ansi = true;
+    } else {
+      sizes.push_back(argv[i]);
+    }
+  }
+  const bool sized = sizes.size() > 1;
+  const int width = sized ? std::atoi(sizes[0]) : ConstSizes::field_width;
+  const int height = sized ? std::atoi(sizes[1]) : ConstSizes::field_height;
+
   using SnakeController = Controller<SnakeModel, UserAction::UP_BTN>;
   using TetrisController = Controller<TetrisModel, UserAction::NO_ACT>;
 
-  SnakeModel snake_model;
+  SnakeModel snake_model(width, height);
   SnakeController snake_controller(&snake_model);
 
-  TetrisModel tetris_model;
+  TetrisModel tetris_model(width, height);
   TetrisController tetris_controller(&tetris_model);
 
-  ConsoleView view(&snake_controller, &tetris_controller);
+  AnsiBackend ansi_backend;
+  ConsoleView view(&snake_controller, &tetris_controller, threaded,
+                   ansi ? &ansi_backend : nullptr);
   view.Start();
   return 0;
 }
\ No newline at end of file
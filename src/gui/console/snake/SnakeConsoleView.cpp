@@ -3,13 +3,19 @@
 namespace s21 {
 
 SnakeConsoleView::SnakeConsoleView(SnakeController* s_c)
-    : action_(UserAction::NO_ACT), data_(), controller_(s_c) {}
+    : data_(), controller_(s_c) {}
 
 void SnakeConsoleView::Start() {
-  nodelay(stdscr, TRUE);
   controller_->setModelToDefault();
+  setFieldSize(controller_->getFieldWidth(), controller_->getFieldHeight());
+  eraseScreen();
   data_ = &controller_->getModelData();
-  SnakeMainLoop();
+  drawn_version_ = 0;
+  if (isThreaded()) {
+    SnakeThreadedLoop();
+  } else {
+    SnakeMainLoop();
+  }
 
   if (data_->game_state == GameState::GAMEOVER ||
       data_->game_state == GameState::EXIT) {
@@ -19,14 +25,19 @@ void SnakeConsoleView::Start() {
 }
 
 void SnakeConsoleView::checkState() {
-  if (data_->was_modified) {
-    if (data_->game_state == GameState::START) {
-      renderStartInfo();
-    } else if (data_->game_state == GameState::PAUSE) {
-      renderPauseInfo(data_->lvl, data_->cur_score, data_->best_score);
-    } else {
-      renderGame();
-    }
+  if (controller_->getModelChanges(drawn_version_)) {
+    drawn_version_ = controller_->getModelVersion();
+    renderState();
+  }
+}
+
+void SnakeConsoleView::renderState() {
+  if (data_->game_state == GameState::START) {
+    renderStartInfo();
+  } else if (data_->game_state == GameState::PAUSE) {
+    renderPauseInfo(data_->lvl, data_->cur_score, data_->best_score);
+  } else {
+    renderGame();
   }
 }
 
@@ -34,42 +45,59 @@ void SnakeConsoleView::SnakeMainLoop() {
   while (data_->game_state != GameState::GAMEOVER &&
          data_->game_state != GameState::EXIT) {
     checkState();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    action_ = getAction();
+    waitForInput(controller_->getTimeToDeadline());
+    for (UserAction action : readActions()) controller_->postAction(action);
     updateModel();
   }
 }
 
+void SnakeConsoleView::SnakeThreadedLoop() {
+  controller_->startSimulation();
+  while (data_->game_state != GameState::GAMEOVER &&
+         data_->game_state != GameState::EXIT) {
+    /* checked before the snapshot is taken, so that it shows these keys */
+    const bool applied = controller_->isInputApplied();
+    const auto& snapshot = controller_->getSnapshot();
+    data_ = &snapshot.data;
+    if (snapshot.version != drawn_version_) {
+      drawn_version_ = snapshot.version;
+      renderState();
+    }
+    /* the start and pause screens wait for a key once the snapshot on
+       screen shows every key posted */
+    const bool idle = data_->game_state == GameState::START ||
+                      data_->game_state == GameState::PAUSE;
+    waitForInput(idle && applied ? BaseModel::kNoDeadline
+                                 : ConstSizes::tick_ms);
+    for (UserAction action : readActions()) controller_->postAction(action);
+  }
+  controller_->stopSimulation();
+  data_ = &controller_->getModelData();
+}
+
 void SnakeConsoleView::updateModel() {
-  controller_->updateModelData(action_);
+  controller_->applyInput();
   data_ = &controller_->getModelData();
-  action_ = UserAction::NO_ACT;
 }
 void SnakeConsoleView::renderGame() {
-  clear();
+  renderGameField(WidgetChoice::SNAKE, data_->lvl, data_->cur_score,
+                  data_->best_score);
+  clearField();
 
   /* Food */
-  attron(COLOR_PAIR(1));
-  mvprintw(data_->fruit_coord.y_ + 1, data_->fruit_coord.x_ + 1, "%c", '1');
-  attroff(COLOR_PAIR(1));
+  putFieldCell(data_->fruit_coord.y_, data_->fruit_coord.x_, '1', 1);
 
   /* Snake */
-  attron(COLOR_PAIR(2));
-
   std::string scoreStr = std::to_string(data_->cur_score);
   size_t scoreLen = scoreStr.length();
   size_t snakeLen = data_->snake_coord.size();
 
   for (size_t i = 0; i < snakeLen; ++i) {
     char ch = (i < scoreLen) ? scoreStr[i] : '0';
-    mvprintw(data_->snake_coord[i].y_ + 1, data_->snake_coord[i].x_ + 1, "%c",
-             ch);
+    putFieldCell(data_->snake_coord[i].y_, data_->snake_coord[i].x_, ch, 2);
   }
-  attroff(COLOR_PAIR(2));
 
-  renderGameField(WidgetChoice::SNAKE, data_->lvl, data_->cur_score,
-                  data_->best_score);
-  refresh();
+  presentFrame();
 }
 
-}  // namespace s21
\ No newline at end of file
+}  // namespace s21
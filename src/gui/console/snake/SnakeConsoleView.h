@@ -38,7 +38,13 @@ class SnakeConsoleView : public BaseConsoleView {
   void SnakeMainLoop();
 
   /**
-   * @brief Updates the model based on the current action.
+   * @brief Main loop drawing the snapshots of a model that ticks on the
+   * simulation thread.
+   */
+  void SnakeThreadedLoop();
+
+  /**
+   * @brief Ticks the model with the actions queued since the last tick.
    */
   void updateModel();
 
@@ -47,10 +53,15 @@ class SnakeConsoleView : public BaseConsoleView {
    */
   void checkState();
 
-  UserAction action_{};  ///< The current action performed by the user.
-  SnakeModel::GameData*
+  /**
+   * @brief Draws the screen of the current game state.
+   */
+  void renderState();
+
+  const SnakeModel::GameData*
       data_;  ///< Pointer to the game data of the Snake model.
   SnakeController* controller_;  ///< Pointer to the SnakeController object.
+  unsigned long long drawn_version_{};  ///< Model version on the screen.
 };
 
 }  // namespace s21
@@ -4,15 +4,20 @@ namespace s21 {
 
 TetrisConsoleView::TetrisConsoleView(TetrisController *c) : controller_(c) {
   data_ = &controller_->getModelData();
-  action_ = UserAction::NO_ACT;
 }
 
 void TetrisConsoleView::Start() {
-  nodelay(stdscr, TRUE);
   controller_->setModelToDefault();
+  setFieldSize(controller_->getFieldWidth(), controller_->getFieldHeight());
+  eraseScreen();
   data_ = &controller_->getModelData();
+  drawn_version_ = 0;
 
-  TetrisMainLoop();
+  if (isThreaded()) {
+    TetrisThreadedLoop();
+  } else {
+    TetrisMainLoop();
+  }
 
   if (data_->game_state == GameState::GAMEOVER ||
       data_->game_state == GameState::EXIT) {
@@ -24,64 +29,94 @@ void TetrisConsoleView::TetrisMainLoop() {
   while (data_->game_state != GameState::GAMEOVER &&
          data_->game_state != GameState::EXIT) {
     checkState();
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    action_ = getAction();
+    waitForInput(controller_->getTimeToDeadline());
+    for (UserAction action : readActions()) controller_->postAction(action);
     updateModel();
   }
 }
 
-void TetrisConsoleView::checkState() {
-  if (data_->was_modified) {
-    if (data_->game_state == GameState::START) {
-      renderStartInfo();
-    } else if (data_->game_state == GameState::PAUSE) {
-      renderPauseInfo(data_->lvl, data_->cur_score, data_->best_score);
-    } else {
-      renderGame();
+void TetrisConsoleView::TetrisThreadedLoop() {
+  controller_->startSimulation();
+  while (data_->game_state != GameState::GAMEOVER &&
+         data_->game_state != GameState::EXIT) {
+    /* checked before the snapshot is taken, so that it shows these keys */
+    const bool applied = controller_->isInputApplied();
+    const auto &snapshot = controller_->getSnapshot();
+    data_ = &snapshot.data;
+    if (snapshot.version != drawn_version_) {
+      drawn_version_ = snapshot.version;
+      renderState();
     }
+    /* the start and pause screens wait for a key once the snapshot on
+       screen shows every key posted */
+    const bool idle = data_->game_state == GameState::START ||
+                      data_->game_state == GameState::PAUSE;
+    waitForInput(idle && applied ? BaseModel::kNoDeadline
+                                 : ConstSizes::tick_ms);
+    for (UserAction action : readActions()) controller_->postAction(action);
+  }
+  controller_->stopSimulation();
+  data_ = &controller_->getModelData();
+}
+
+void TetrisConsoleView::checkState() {
+  if (controller_->getModelChanges(drawn_version_)) {
+    drawn_version_ = controller_->getModelVersion();
+    renderState();
+  }
+}
+
+void TetrisConsoleView::renderState() {
+  if (data_->game_state == GameState::START) {
+    renderStartInfo();
+  } else if (data_->game_state == GameState::PAUSE) {
+    renderPauseInfo(data_->lvl, data_->cur_score, data_->best_score);
+  } else {
+    renderGame();
   }
 }
 
 void TetrisConsoleView::updateModel() {
-  controller_->updateModelData(action_);
+  controller_->applyInput();
   data_ = &controller_->getModelData();
-  action_ = UserAction::NO_ACT;
 }
 
 void TetrisConsoleView::renderGame() {
-  clear();
   renderGameField(WidgetChoice::TETRIS, data_->lvl, data_->cur_score,
                   data_->best_score);
+  clearField();
+  frame_.clear({field_w_ + 3, 2},
+               {windowWidth() - 2, ConstSizes::console_info_panel_h - 1});
 
   const auto &projection = data_->projection.getCords();
   const auto &cur_figure = data_->cur_figure.getCords();
   const auto &next_figure = data_->next_figure.getCords();
   const auto &game_field = data_->game_field;
 
-  attron(COLOR_PAIR(8));
   for (const auto &item : projection) {
-    mvprintw(item.y_, item.x_ + 1, ".");
+    putFieldCell(item.y_ - 1, item.x_, '.', 8);
   }
-  attroff(COLOR_PAIR(8));
 
-  attron(COLOR_PAIR((short)data_->cur_figure.getShape()));
+  const short cur_color = static_cast<short>(data_->cur_figure.getShape());
   for (const auto &item : cur_figure) {
-    mvprintw(item.y_, item.x_ + 1, ".");
+    putFieldCell(item.y_ - 1, item.x_, '.', cur_color);
   }
-  attroff(COLOR_PAIR((short)data_->cur_figure.getShape()));
 
-  attron(COLOR_PAIR((short)data_->next_figure.getShape()));
+  const short next_color = static_cast<short>(data_->next_figure.getShape());
   for (const auto &item : next_figure) {
-    mvprintw(item.y_ + 2, item.x_ + 11, ".");
+    frame_.put(item.y_ + 2, item.x_ + field_w_ - field_w_ / 2 + 6, '.',
+               next_color);
   }
-  attroff(COLOR_PAIR((short)data_->next_figure.getShape()));
 
-  for (int i = 0; i < ConstSizes::field_height; ++i) {
-    for (int j = 0; j < ConstSizes::field_width; ++j) {
-      attron(COLOR_PAIR(game_field[i][j].second));
-      if (game_field[i][j].first) mvprintw(i + 1, j + 1, ".");
-      attroff(COLOR_PAIR(game_field[i][j].second));
+  for (int i = 0; i < game_field.height(); ++i) {
+    if (game_field.isRowEmpty(i)) continue;
+    for (int j = 0; j < game_field.width(); ++j) {
+      if (!game_field.isFilled(i, j)) continue;
+      putFieldCell(i, j, '.', static_cast<short>(game_field.getColor(i, j)));
     }
   }
+
+  presentFrame();
 }
-}  // namespace s21
\ No newline at end of file
+
+}  // namespace s21
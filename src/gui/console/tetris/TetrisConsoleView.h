@@ -28,20 +28,26 @@ class TetrisConsoleView : public BaseConsoleView {
   void Start() override;
 
  private:
-  UserAction action_;  ///< The current action performed by the user.
-
-  TetrisModel::GameData
+  const TetrisModel::GameData
       *data_;  ///< Pointer to the game data of the Tetris model.
 
   TetrisController *controller_;  ///< Pointer to the TetrisController object.
 
+  unsigned long long drawn_version_{};  ///< Model version on the screen.
+
   /**
    * @brief Main loop for running the Tetris game.
    */
   void TetrisMainLoop();
 
   /**
-   * @brief Updates the model based on the current action.
+   * @brief Main loop drawing the snapshots of a model that ticks on the
+   * simulation thread.
+   */
+  void TetrisThreadedLoop();
+
+  /**
+   * @brief Ticks the model with the actions queued since the last tick.
    */
   void updateModel();
 
@@ -54,6 +60,11 @@ class TetrisConsoleView : public BaseConsoleView {
    * @brief Checks the current state of the game.
    */
   void checkState();
+
+  /**
+   * @brief Draws the screen of the current game state.
+   */
+  void renderState();
 };
 
 }  // namespace s21
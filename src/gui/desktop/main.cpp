@@ -1,4 +1,7 @@
 #include <QApplication>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 
 #include "../../brick_game/snake/SnakeModel.h"
 #include "../../controller/Controller.h"
@@ -7,15 +10,30 @@
 int main(int argc, char *argv[]) {
   QApplication a(argc, argv);
 
-  s21::SnakeModel snake_model;
-  s21::TetrisModel tetris_model;
+  /* [--threaded] [WIDTH HEIGHT] after the Qt options */
+  bool threaded = false;
+  std::vector<const char *> sizes;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--threaded") == 0) {
+      threaded = true;
+    } else {
+      sizes.push_back(argv[i]);
+    }
+  }
+  const bool sized = sizes.size() > 1;
+  const int width = sized ? std::atoi(sizes[0]) : s21::ConstSizes::field_width;
+  const int height =
+      sized ? std::atoi(sizes[1]) : s21::ConstSizes::field_height;
+
+  s21::SnakeModel snake_model(width, height);
+  s21::TetrisModel tetris_model(width, height);
 
   s21::Controller<s21::SnakeModel, s21::UserAction::UP_BTN> snake_controller(
       &snake_model);
   s21::Controller<s21::TetrisModel, s21::UserAction::NO_ACT> tetris_controller(
       &tetris_model);
 
-  s21::MainWindow w(&snake_controller, &tetris_controller);
+  s21::MainWindow w(&snake_controller, &tetris_controller, threaded);
   w.show();
   return a.exec();
 }
@@ -1,4 +1,6 @@
 #include <QDir>
+#include <algorithm>
+#include <limits>
 
 #include "./ui_mainwindow.h"
 #include "mainwindow.h"
@@ -6,11 +8,11 @@
 namespace s21 {
 
 MainWindow::MainWindow(SnakeController *s_c, TetrisController *t_c,
-                       QWidget *parent)
+                       bool threaded, QWidget *parent)
     : QMainWindow(parent),
       ui(new Ui::MainWindow),
       cur_widget_(CurWidget::MENU),
-      action_(UserAction::NO_ACT),
+      threaded_(threaded),
       snake_data_(nullptr),
       tetris_data_(nullptr),
       snake_controller_(s_c),
@@ -19,6 +21,11 @@ MainWindow::MainWindow(SnakeController *s_c, TetrisController *t_c,
   ui->stackedWidget->setCurrentIndex(0);
   setWindowTitle("Brick Game");
   m_timer_ = new QTimer(this);
+  m_timer_->setSingleShot(true);
+
+  /* decoded once, from the resources rather than the working directory */
+  food_image_ = QImage(":/sprites/food.png");
+  head_image_ = QImage(":/sprites/head.png");
 
   connect(m_timer_, &QTimer::timeout, this, &MainWindow::UpdateWindow);
   connect(ui->initSnakeButton, &QPushButton::released, this,
@@ -33,7 +40,10 @@ MainWindow::MainWindow(SnakeController *s_c, TetrisController *t_c,
           &MainWindow::MainMenuExitClicked);
 }
 
-MainWindow::~MainWindow() { delete ui; }
+MainWindow::~MainWindow() {
+  stopSimulation();
+  delete ui;
+}
 
 void MainWindow::SnakeButtonClicked() {
   cur_widget_ = CurWidget::SNAKE;
@@ -48,77 +58,76 @@ void MainWindow::TetrisButtonClicked() {
 }
 
 void MainWindow::initGame() {
+  stopSimulation();
   if (cur_widget_ == CurWidget::SNAKE) {
     snake_controller_->setModelToDefault();
     snake_data_ = &snake_controller_->getModelData();
+    if (threaded_) snake_controller_->startSimulation();
   } else if (cur_widget_ == CurWidget::TETRIS) {
     tetris_controller_->setModelToDefault();
     tetris_data_ = &tetris_controller_->getModelData();
+    board_layer_ = QPixmap();
+    layer_version_ = 0;
+    if (threaded_) tetris_controller_->startSimulation();
   }
   ui->stackedWidget->setCurrentIndex((int)cur_widget_);
-  m_timer_->start(10);
+  drawn_version_ = 0;
+  shown_lvl_ = shown_score_ = shown_best_ = -1;
+  update();
+  m_timer_->start(0);
+}
+
+void MainWindow::stopSimulation() {
+  snake_controller_->stopSimulation();
+  tetris_controller_->stopSimulation();
 }
 
 void MainWindow::paintEvent(QPaintEvent *event) {
   QMainWindow::paintEvent(event);
 
+  /* draws only; a game that ended is taken off the screen by its update */
   if (cur_widget_ == CurWidget::SNAKE) {
-    bool gameover_or_exit = snake_data_->game_state == GameState::GAMEOVER ||
-                            snake_data_->game_state == GameState::EXIT;
-    if (gameover_or_exit) {
-      ClearScreen();
-      RenderGameOverMenu(snake_data_->win, snake_data_->cur_score,
-                         snake_data_->best_score);
-    } else {
-      switch (snake_data_->game_state) {
-        case GameState::START: {
-          RenderStartScreen(ui->snake_start_info);
-          break;
-        }
-        case GameState::PAUSE: {
-          RenderPauseScreen(ui->snake_start_info);
-          break;
-        }
-        default:
-          ui->snake_start_info->setText("");
-          RenderSnakeGame();
-          break;
+    switch (snake_data_->game_state) {
+      case GameState::START: {
+        RenderStartScreen(ui->snake_start_info);
+        break;
       }
+      case GameState::PAUSE: {
+        RenderPauseScreen(ui->snake_start_info);
+        break;
+      }
+      case GameState::GAMEOVER:
+      case GameState::EXIT:
+        break;
+      default:
+        ui->snake_start_info->setText("");
+        RenderSnakeGame();
+        break;
     }
   } else if (cur_widget_ == CurWidget::TETRIS) {
-    bool gameover_or_exit = tetris_data_->game_state == GameState::GAMEOVER ||
-                            tetris_data_->game_state == GameState::EXIT;
-    if (gameover_or_exit) {
-      ClearScreen();
-      RenderGameOverMenu(false, tetris_data_->cur_score,
-                         tetris_data_->best_score);
-    } else {
-      switch (tetris_data_->game_state) {
-        case GameState::START: {
-          RenderStartScreen(ui->tetris_start_info);
-          break;
-        }
-        case GameState::PAUSE: {
-          RenderPauseScreen(ui->tetris_start_info);
-          break;
-        }
-        default:
-          ui->tetris_start_info->setText("");
-          RenderTetrisGame();
-          break;
+    switch (tetris_data_->game_state) {
+      case GameState::START: {
+        RenderStartScreen(ui->tetris_start_info);
+        break;
       }
+      case GameState::PAUSE: {
+        RenderPauseScreen(ui->tetris_start_info);
+        break;
+      }
+      case GameState::GAMEOVER:
+      case GameState::EXIT:
+        break;
+      default:
+        ui->tetris_start_info->setText("");
+        RenderTetrisGame();
+        break;
     }
   }
 }
 
-void MainWindow::ClearScreen() {
-  QPainter painter(this);
-  painter.eraseRect(rect());
-  painter.end();
-}
-
-void MainWindow::RenderGameOverMenu(bool win, int score, int best_score) {
+void MainWindow::ShowGameOverMenu(bool win, int score, int best_score) {
   m_timer_->stop();
+  stopSimulation();
   ui->stackedWidget->setCurrentIndex(
       static_cast<int>(CurWidget::GAMEOVER_MENU));
 
@@ -128,35 +137,48 @@ void MainWindow::RenderGameOverMenu(bool win, int score, int best_score) {
 }
 
 void MainWindow::keyPressEvent(QKeyEvent *event) {
+  UserAction action = UserAction::NO_ACT;
   int key = event->key();
   switch (key) {
     case Qt::Key_Left:
-      action_ = UserAction::LEFT_BTN;
+      action = UserAction::LEFT_BTN;
       break;
     case Qt::Key_Right:
-      action_ = UserAction::RIGHT_BTN;
+      action = UserAction::RIGHT_BTN;
       break;
     case Qt::Key_Up:
-      action_ = UserAction::UP_BTN;
+      action = UserAction::UP_BTN;
       break;
     case Qt::Key_Down:
-      action_ = UserAction::DOWN_BTN;
+      action = UserAction::DOWN_BTN;
       break;
     case Qt::Key_Enter:
-      action_ = UserAction::ENTER_BTN;
+      action = UserAction::ENTER_BTN;
       break;
     case Qt::Key_Tab:
-      action_ = UserAction::TAB_BTN;
+      action = UserAction::TAB_BTN;
       break;
     case Qt::Key_Space:
-      action_ = UserAction::SPACE_BTN;
+      action = UserAction::SPACE_BTN;
       break;
     case Qt::Key_Escape:
-      action_ = UserAction::ESC_BTN;
+      action = UserAction::ESC_BTN;
       break;
     default:
       break;
   }
+
+  if (action == UserAction::NO_ACT) return;
+  if (ui->stackedWidget->currentIndex() != static_cast<int>(cur_widget_)) {
+    return;
+  }
+  if (cur_widget_ == CurWidget::SNAKE) {
+    snake_controller_->postAction(action);
+  } else if (cur_widget_ == CurWidget::TETRIS) {
+    tetris_controller_->postAction(action);
+  }
+  /* the simulation thread needs a tick to take the key in */
+  m_timer_->start(threaded_ ? ConstSizes::tick_ms : 0);
 }
 
 void MainWindow::UpdateWindow() {
@@ -165,67 +187,135 @@ void MainWindow::UpdateWindow() {
   } else if (cur_widget_ == CurWidget::TETRIS) {
     UpdateTetrisModel();
   }
-  repaint();
 }
 
 void MainWindow::UpdateSnakeModel() {
-  snake_controller_->updateModelData(action_);
-  snake_data_ = &snake_controller_->getModelData();
-  action_ = UserAction::NO_ACT;
-  ui->level->setText(QString::number(snake_data_->lvl));
-  ui->score->setText(QString::number(snake_data_->cur_score));
-  ui->bestScore->setText(QString::number(snake_data_->best_score));
+  unsigned changes = 0;
+  if (threaded_) {
+    const auto &snapshot = snake_controller_->getSnapshot();
+    snake_data_ = &snapshot.data;
+    if (snapshot.version != drawn_version_) changes = kAllChanges;
+    drawn_version_ = snapshot.version;
+  } else {
+    snake_controller_->applyInput();
+    snake_data_ = &snake_controller_->getModelData();
+    changes = snake_controller_->getModelChanges(drawn_version_);
+    drawn_version_ = snake_controller_->getModelVersion();
+  }
+  UpdateHud(ui->level, ui->score, ui->bestScore, snake_data_->lvl,
+            snake_data_->cur_score, snake_data_->best_score);
+  if (isOver(snake_data_->game_state)) {
+    ShowGameOverMenu(snake_data_->win, snake_data_->cur_score,
+                     snake_data_->best_score);
+    return;
+  }
+
+  if (changes & BaseModel::componentBit(ModelComponent::STATE)) {
+    update();
+  } else if (changes & BaseModel::componentBit(ModelComponent::FIELD)) {
+    update(ui->SnakeField->geometry());
+  }
+  ArmTimer(threaded_ ? BaseModel::kNoDeadline
+                     : snake_controller_->getTimeToDeadline(),
+           snake_data_->game_state);
 }
 
 void MainWindow::UpdateTetrisModel() {
-  tetris_controller_->updateModelData(action_);
-  tetris_data_ = &tetris_controller_->getModelData();
-  action_ = UserAction::NO_ACT;
-  ui->curlvl->setText(QString::number(tetris_data_->lvl));
-  ui->curScore->setText(QString::number(tetris_data_->cur_score));
-  ui->topScore->setText(QString::number(tetris_data_->best_score));
+  unsigned changes = 0;
+  if (threaded_) {
+    const auto &snapshot = tetris_controller_->getSnapshot();
+    tetris_data_ = &snapshot.data;
+    if (snapshot.version != drawn_version_) changes = kAllChanges;
+    drawn_version_ = snapshot.version;
+    /* the snapshots skip versions, so a changed field rebuilds the layer */
+    if (snapshot.field_version != layer_version_) board_layer_ = QPixmap();
+    layer_version_ = snapshot.field_version;
+  } else {
+    tetris_controller_->applyInput();
+    tetris_data_ = &tetris_controller_->getModelData();
+    changes = tetris_controller_->getModelChanges(drawn_version_);
+    drawn_version_ = tetris_controller_->getModelVersion();
+    applyBoardChanges(tetris_controller_->drainModelChanges(),
+                      tetris_data_->game_field);
+  }
+  UpdateHud(ui->curlvl, ui->curScore, ui->topScore, tetris_data_->lvl,
+            tetris_data_->cur_score, tetris_data_->best_score);
+  if (isOver(tetris_data_->game_state)) {
+    ShowGameOverMenu(false, tetris_data_->cur_score, tetris_data_->best_score);
+    return;
+  }
+
+  const unsigned board = BaseModel::componentBit(ModelComponent::FIELD) |
+                         BaseModel::componentBit(ModelComponent::FIGURE);
+  if (changes & BaseModel::componentBit(ModelComponent::STATE)) {
+    update();
+  } else if (changes & board) {
+    /* the pieces may reach a cell past the field and the next box */
+    const QRect field_rect = ui->TetrisField->geometry();
+    const int margin = std::max<int>(
+        ConstSizes::pixel_size,
+        cellSize(field_rect, tetris_controller_->getFieldWidth(),
+                 tetris_controller_->getFieldHeight()));
+    update(field_rect.united(ui->NextFigure->geometry())
+               .adjusted(-margin, -margin, margin, margin));
+  }
+  ArmTimer(threaded_ ? BaseModel::kNoDeadline
+                     : tetris_controller_->getTimeToDeadline(),
+           tetris_data_->game_state);
+}
+
+void MainWindow::UpdateHud(QLabel *lvl_label, QLabel *score_label,
+                           QLabel *best_label, int lvl, int score,
+                           int best_score) {
+  if (lvl != shown_lvl_) {
+    shown_lvl_ = lvl;
+    lvl_label->setText(QString::number(lvl));
+  }
+  if (score != shown_score_) {
+    shown_score_ = score;
+    score_label->setText(QString::number(score));
+  }
+  if (best_score != shown_best_) {
+    shown_best_ = best_score;
+    best_label->setText(QString::number(best_score));
+  }
+}
+
+void MainWindow::ArmTimer(long long time_to_deadline, GameState state) {
+  if (threaded_) {
+    /* the snapshots are polled, slowly while the game waits for a key */
+    const bool waiting = state == GameState::START || state == GameState::PAUSE;
+    m_timer_->start(waiting ? kIdlePollMs : ConstSizes::tick_ms);
+  } else if (time_to_deadline == BaseModel::kNoDeadline) {
+    /* nothing changes until a key press wakes the window */
+    m_timer_->stop();
+  } else {
+    const long long max_wait = std::numeric_limits<int>::max();
+    m_timer_->start(static_cast<int>(std::min(time_to_deadline, max_wait)));
+  }
 }
 
 void MainWindow::RenderSnakeGame() {
   QRect snakeFieldRect = ui->SnakeField->geometry();
   QPainter qp(this);
 
-  QImage food("images/food.png");
-  QImage head("images/head.png");
+  const int pixel_size =
+      cellSize(snakeFieldRect, snake_controller_->getFieldWidth(),
+               snake_controller_->getFieldHeight());
+  updateSprites(pixel_size);
 
-  int pixel_size = ConstSizes::pixel_size;
+  auto cellPos = [&](const Cords &cell) {
+    return QPoint(snakeFieldRect.x() + cell.x_ * pixel_size,
+                  snakeFieldRect.y() + cell.y_ * pixel_size);
+  };
 
   auto drawFood = [&]() {
-    QRectF appleRect(
-        snakeFieldRect.x() + snake_data_->fruit_coord.x_ * pixel_size,
-        snakeFieldRect.y() + snake_data_->fruit_coord.y_ * pixel_size,
-        pixel_size, pixel_size);
-    qp.drawImage(appleRect, food);
+    qp.drawPixmap(cellPos(snake_data_->fruit_coord), food_pixmap_);
   };
 
   auto drawSnakeHead = [&]() {
-    QRectF headRect(
-        snakeFieldRect.x() + snake_data_->snake_coord[0].x_ * pixel_size,
-        snakeFieldRect.y() + snake_data_->snake_coord[0].y_ * pixel_size,
-        pixel_size, pixel_size);
-
-    QTransform transform;
-    int rotation = 0;
-    switch (snake_data_->direction) {
-      case Direction::DOWN:
-        rotation = 180;
-        break;
-      case Direction::LEFT:
-        rotation = -90;
-        break;
-      case Direction::RIGHT:
-        rotation = 90;
-        break;
-      default:
-        break;
-    }
-    head = head.transformed(transform.rotate(rotation));
-    qp.drawImage(headRect, head);
+    qp.drawPixmap(cellPos(snake_data_->snake_coord[0]),
+                  head_pixmaps_[static_cast<int>(snake_data_->direction)]);
   };
 
   const QColor body_color(223, 187, 137);
@@ -250,6 +340,30 @@ void MainWindow::RenderSnakeGame() {
   qp.end();
 }
 
+void MainWindow::updateSprites(int pixel_size) {
+  const qreal dpr = devicePixelRatioF();
+  if (pixel_size == sprite_size_ && dpr == sprite_dpr_) return;
+  sprite_size_ = pixel_size;
+  sprite_dpr_ = dpr;
+
+  const int side = qRound(pixel_size * dpr);
+  auto scaled = [&](const QImage &image) {
+    QPixmap pixmap = QPixmap::fromImage(image.scaled(
+        side, side, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    pixmap.setDevicePixelRatio(dpr);
+    return pixmap;
+  };
+
+  food_pixmap_ = scaled(food_image_);
+  /* rotations in the order of Direction: UP, DOWN, LEFT, RIGHT */
+  const int rotations[4] = {0, 180, -90, 90};
+  for (int i = 0; i < 4; ++i) {
+    QTransform transform;
+    head_pixmaps_[i] =
+        scaled(head_image_.transformed(transform.rotate(rotations[i])));
+  }
+}
+
 void MainWindow::RenderTetrisGame() {
   QPainter qp(this);
   const QRect field_rect = ui->TetrisField->geometry();
@@ -257,9 +371,10 @@ void MainWindow::RenderTetrisGame() {
 
   const auto t_data = tetris_data_;
   const auto &colors = Colors;
-  const int pixel_size = ConstSizes::pixel_size;
-  const int field_height = ConstSizes::field_height;
-  const int field_width = ConstSizes::field_width;
+  const int field_height = tetris_controller_->getFieldHeight();
+  const int field_width = tetris_controller_->getFieldWidth();
+  const int pixel_size = cellSize(field_rect, field_width, field_height);
+  const int next_pixel_size = ConstSizes::pixel_size;
 
   const QBrush dark_gray(QColor(90, 90, 90));
   const QPen black(Qt::black);
@@ -269,34 +384,79 @@ void MainWindow::RenderTetrisGame() {
 
   auto drawFigure = [&](const auto &cords, const QRect &rect, int color_index,
                         bool isNext = false) {
+    const int size = isNext ? next_pixel_size : pixel_size;
     for (const auto &item : cords) {
-      int x_offset = isNext ? item.x_ - 2.65 : item.x_;
+      int x_offset = isNext ? item.x_ - field_width / 2 + 2.35 : item.x_;
       int y_offset = isNext ? item.y_ + 1 : item.y_ - 1;
       qp.setBrush(colors[color_index]);
-      qp.drawRect(rect.x() + x_offset * pixel_size,
-                  rect.y() + y_offset * pixel_size, pixel_size - 1,
-                  pixel_size - 1);
+      qp.drawRect(rect.x() + x_offset * size, rect.y() + y_offset * size,
+                  size - 1, size - 1);
     }
   };
 
-  auto drawGameField = [&](const auto &game_field, const QRect &rect) {
-    for (int i = 0; i < field_height; ++i) {
-      for (int j = 0; j < field_width; ++j) {
-        if (game_field[i][j].first) {
-          qp.setBrush(colors[game_field[i][j].second]);
-          qp.drawRect(rect.x() + j * pixel_size, rect.y() + i * pixel_size,
-                      pixel_size - 1, pixel_size - 1);
-        }
-      }
-    }
-  };
+  /* locked cells from the cached layer, the moving pieces on top */
+  updateBoardLayer(t_data->game_field, pixel_size);
+  qp.drawPixmap(field_rect.topLeft(), board_layer_);
 
   drawFigure(t_data->projection.getCords(), field_rect, 8);
   drawFigure(t_data->cur_figure.getCords(), field_rect,
              static_cast<int>(t_data->cur_figure.getShape()));
   drawFigure(t_data->next_figure.getCords(), next_rect,
              static_cast<int>(t_data->next_figure.getShape()), true);
-  drawGameField(t_data->game_field, field_rect);
+}
+
+void MainWindow::updateBoardLayer(const Board &field, int pixel_size) {
+  const qreal dpr = devicePixelRatioF();
+  if (!board_layer_.isNull() && pixel_size == layer_size_ &&
+      dpr == layer_dpr_) {
+    return;
+  }
+
+  layer_size_ = pixel_size;
+  layer_dpr_ = dpr;
+  board_layer_ = QPixmap(qRound(field.width() * pixel_size * dpr),
+                         qRound(field.height() * pixel_size * dpr));
+  board_layer_.setDevicePixelRatio(dpr);
+  board_layer_.fill(Qt::transparent);
+
+  QPainter painter(&board_layer_);
+  painter.setPen(QPen(Qt::black));
+  for (int i = 0; i < field.height(); ++i) {
+    if (field.isRowEmpty(i)) continue;
+    for (int j = 0; j < field.width(); ++j) {
+      if (field.isFilled(i, j)) paintBoardCell(painter, field, i, j);
+    }
+  }
+  painter.end();
+}
+
+void MainWindow::applyBoardChanges(const ChangeLog &log, const Board &field) {
+  if (board_layer_.isNull()) return;
+  if (log.full_redraw) {
+    board_layer_ = QPixmap();
+    return;
+  }
+  if (log.cells.empty()) return;
+
+  /* the log also lists the cells of the moving pieces, whose colors are no
+     part of the layer, so every cell is taken from the board itself */
+  QPainter painter(&board_layer_);
+  painter.setPen(QPen(Qt::black));
+  for (const CellChange &change : log.cells) {
+    paintBoardCell(painter, field, change.cell.y_, change.cell.x_);
+  }
+  painter.end();
+}
+
+void MainWindow::paintBoardCell(QPainter &painter, const Board &field,
+                                int row, int col) {
+  const int size = layer_size_;
+  painter.setCompositionMode(QPainter::CompositionMode_Source);
+  painter.fillRect(col * size, row * size, size, size, Qt::transparent);
+  painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+  if (!field.isFilled(row, col)) return;
+  painter.setBrush(Colors[field.getColor(row, col)]);
+  painter.drawRect(col * size, row * size, size - 1, size - 1);
 }
 
 void MainWindow::RenderStartScreen(QLabel *p_label) {
@@ -326,4 +486,12 @@ void MainWindow::GameOverPlayAgainClicked() {
 
 void MainWindow::MainMenuExitClicked() { close(); }
 
+bool MainWindow::isOver(GameState state) {
+  return state == GameState::GAMEOVER || state == GameState::EXIT;
+}
+
+int MainWindow::cellSize(const QRect &rect, int width, int height) {
+  return std::max(1, std::min(rect.width() / width, rect.height() / height));
+}
+
 }  // namespace s21
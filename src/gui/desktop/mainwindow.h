@@ -6,6 +6,7 @@
 #include <QMainWindow>
 #include <QMessageBox>
 #include <QPainter>
+#include <QPixmap>
 #include <QString>
 #include <QTimer>
 #include <QWidget>
@@ -56,10 +57,11 @@ class MainWindow : public QMainWindow {
    *
    * @param s_c Pointer to the Snake controller.
    * @param t_c Pointer to the Tetris controller.
+   * @param threaded Whether the games tick on the simulation thread.
    * @param parent Pointer to the parent widget.
    */
   MainWindow(SnakeController *s_c, TetrisController *t_c,
-             QWidget *parent = nullptr);
+             bool threaded = false, QWidget *parent = nullptr);
 
   /**
    * @brief Destroys the MainWindow object.
@@ -107,27 +109,108 @@ class MainWindow : public QMainWindow {
   void MainMenuExitClicked();
 
  private:
+  /// Mask standing for a change of every component
+  static constexpr unsigned kAllChanges = ~0u;
+  /// Snapshot polling period while a threaded game waits for a key
+  static constexpr int kIdlePollMs = 100;
+
   Ui::MainWindow *ui;
   QTimer *m_timer_;
   CurWidget cur_widget_;
-  UserAction action_{};
+  bool threaded_;
+
+  unsigned long long drawn_version_ = 0;  ///< Model version on the screen
+  int shown_lvl_ = -1;                    ///< Level in the HUD label
+  int shown_score_ = -1;                  ///< Score in the HUD label
+  int shown_best_ = -1;                   ///< Best score in the HUD label
 
-  SnakeModel::GameData *snake_data_;
-  TetrisModel::GameData *tetris_data_;
+  const SnakeModel::GameData *snake_data_;
+  const TetrisModel::GameData *tetris_data_;
 
   SnakeController *snake_controller_;
   TetrisController *tetris_controller_;
 
+  QImage food_image_;        ///< Decoded food sprite
+  QImage head_image_;        ///< Decoded head sprite, facing up
+  QPixmap food_pixmap_;      ///< Food scaled to a cell
+  QPixmap head_pixmaps_[4];  ///< Head scaled to a cell, per Direction
+  int sprite_size_ = 0;      ///< Cell size the pixmaps are scaled to
+  qreal sprite_dpr_ = 0;     ///< Device pixel ratio of the pixmaps
+
+  QPixmap board_layer_;                   ///< Locked cells, null if invalid
+  int layer_size_ = 0;                    ///< Cell size of the layer
+  qreal layer_dpr_ = 0;                   ///< Device pixel ratio of the layer
+  unsigned long long layer_version_ = 0;  ///< Field version of the layer
+
+  /**
+   * @brief Scales and rotates the snake sprites for a cell size, unless
+   * they already fit it and the current device pixel ratio.
+   *
+   * @param pixel_size The side of a cell in logical pixels.
+   */
+  void updateSprites(int pixel_size);
+
   /**
-   * @brief Clears the screen.
+   * @brief Paints the whole layer of locked Tetris cells when it is invalid:
+   * after a restart, or when the cell size or the device pixel ratio
+   * changed. A valid layer is kept up to date by applyBoardChanges().
+   *
+   * @param field The board to show.
+   * @param pixel_size The side of a cell in logical pixels.
    */
-  void ClearScreen();
+  void updateBoardLayer(const Board &field, int pixel_size);
 
   /**
-   * @brief Updates the window.
+   * @brief Paints again the cells of the board layer the model logged as
+   * changed, the rows moved by a line clear included, or invalidates the
+   * layer when the model asks for a full redraw.
+   *
+   * @param log The changes drained from the model.
+   * @param field The board the cells are taken from.
+   */
+  void applyBoardChanges(const ChangeLog &log, const Board &field);
+
+  /**
+   * @brief Paints one cell of the board layer.
+   *
+   * @param painter The painter of the layer.
+   * @param field The board the cell is taken from.
+   * @param row The row of the cell.
+   * @param col The column of the cell.
+   */
+  void paintBoardCell(QPainter &painter, const Board &field, int row,
+                      int col);
+
+  /**
+   * @brief Updates the model of the current game and schedules a repaint
+   * of what changed.
    */
   void UpdateWindow();
 
+  /**
+   * @brief Sets the HUD labels whose values changed.
+   *
+   * @param lvl_label The label of the level.
+   * @param score_label The label of the score.
+   * @param best_label The label of the best score.
+   * @param lvl The level.
+   * @param score The score.
+   * @param best_score The best score.
+   */
+  void UpdateHud(QLabel *lvl_label, QLabel *score_label, QLabel *best_label,
+                 int lvl, int score, int best_score);
+
+  /**
+   * @brief Arms the update timer for the next model change, or stops it
+   * while only a key press can change the model. Not called once the game
+   * is over.
+   *
+   * @param time_to_deadline The time left to the next deadline of the
+   * model, BaseModel::kNoDeadline if it has none.
+   * @param state The state of the game.
+   */
+  void ArmTimer(long long time_to_deadline, GameState state);
+
   /**
    * @brief Renders the Snake game.
    */
@@ -154,13 +237,18 @@ class MainWindow : public QMainWindow {
   void initGame();
 
   /**
-   * @brief Renders the Game Over menu.
+   * @brief Stops the simulation threads of both games.
+   */
+  void stopSimulation();
+
+  /**
+   * @brief Stops the game that ended and switches to the Game Over menu.
    *
    * @param win Boolean indicating if the player won.
    * @param score The player's score.
    * @param best_score The best score.
    */
-  void RenderGameOverMenu(bool win, int score, int best_score);
+  void ShowGameOverMenu(bool win, int score, int best_score);
 
   /**
    * @brief Renders the start screen.
@@ -175,6 +263,24 @@ class MainWindow : public QMainWindow {
    * @param p_label Pointer to the label widget.
    */
   static void RenderPauseScreen(QLabel *p_label);
+
+  /**
+   * @brief Computes the cell size that fits a game field into a widget.
+   *
+   * @param rect The geometry of the widget.
+   * @param width The number of columns of the game field.
+   * @param height The number of rows of the game field.
+   * @return The side of a cell in pixels, at least 1.
+   */
+  static int cellSize(const QRect &rect, int width, int height);
+
+  /**
+   * @brief Checks whether a game has ended.
+   *
+   * @param state The state of the game.
+   * @return true on GAMEOVER or EXIT; false otherwise.
+   */
+  static bool isOver(GameState state);
 };
 
 }  // namespace s21
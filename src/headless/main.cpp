@@ -0,0 +1,48 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#include "SelfPlayPolicies.h"
+
+using namespace s21;
+
+template <typename Model>
+static SelfPlayStats playBatch(const SelfPlayConfig &config,
+                               typename SelfPlayRunner<Model>::Policy policy) {
+  SelfPlayRunner<Model> runner(config, std::move(policy));
+  std::cout << "threads: " << runner.threads() << '\n';
+  return runner.run();
+}
+
+static void printStats(const SelfPlayStats &stats) {
+  std::cout << "games: " << stats.games.size() << " (" << stats.finished
+            << " finished, " << stats.wins << " won, " << stats.stolen
+            << " stolen)\n"
+            << "score: mean " << stats.mean_score << ", min "
+            << stats.min_score << ", median " << stats.median_score
+            << ", p90 " << stats.p90_score << ", max " << stats.max_score
+            << '\n'
+            << "lines: mean " << stats.mean_lines << '\n'
+            << "levels:";
+  for (size_t lvl = 1; lvl < stats.levels.size(); ++lvl) {
+    if (stats.levels[lvl]) std::cout << ' ' << lvl << ':' << stats.levels[lvl];
+  }
+  std::cout << '\n'
+            << "time: " << stats.seconds << " s, " << stats.games_per_second
+            << " games/s, " << stats.steps_per_second << " steps/s\n";
+}
+
+int main(int argc, char *argv[]) {
+  /* brick_game_selfplay [snake|tetris] [GAMES] [THREADS] [SEED] [MAX_STEPS] */
+  const bool snake = argc > 1 && std::strcmp(argv[1], "snake") == 0;
+  SelfPlayConfig config;
+  config.games = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+  config.threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 0;
+  config.seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 0;
+  if (argc > 5) config.max_steps = std::strtoull(argv[5], nullptr, 10);
+
+  printStats(snake ? playBatch<SnakeModel>(config, greedySnakePolicy())
+                   : playBatch<TetrisModel>(config, randomTetrisPolicy()));
+  return 0;
+}
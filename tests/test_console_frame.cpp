@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "../src/gui/console/base/AnsiBackend.h"
+#include "../src/gui/console/base/ConsoleFrame.h"
+
+using namespace s21;
+
+TEST(TestConsoleFrame, FirstDiffDrawsEverything) {
+  ConsoleFrame frame;
+  frame.resize(6, 2);
+  frame.print(0, 1, "ab", 3);
+
+  const auto &runs = frame.diff();
+  ASSERT_EQ(runs.size(), 4u);
+  EXPECT_EQ(runs[0].x, 0);
+  EXPECT_EQ(runs[0].length, 1);
+  EXPECT_EQ(runs[1].x, 1);
+  EXPECT_EQ(runs[1].length, 2);
+  EXPECT_EQ(runs[1].color, 3);
+  EXPECT_EQ(runs[2].length, 3);
+  EXPECT_EQ(runs[3].y, 1);
+  EXPECT_EQ(runs[3].length, 6);
+
+  EXPECT_TRUE(frame.diff().empty());
+}
+
+TEST(TestConsoleFrame, OnlyChangedCells) {
+  ConsoleFrame frame;
+  frame.resize(20, 3);
+  frame.box({0, 0}, {19, 2});
+  frame.diff();
+
+  frame.put(1, 3, '.', 2);
+  const auto &runs = frame.diff();
+  ASSERT_EQ(runs.size(), 1u);
+  EXPECT_EQ(runs[0].y, 1);
+  EXPECT_EQ(runs[0].x, 3);
+  EXPECT_EQ(runs[0].length, 1);
+  EXPECT_EQ(runs[0].color, 2);
+
+  frame.clear({1, 1}, {18, 1});
+  ASSERT_EQ(frame.diff().size(), 1u);
+  EXPECT_TRUE(frame.diff().empty());
+}
+
+TEST(TestConsoleFrame, RunsBridgeShortGaps) {
+  ConsoleFrame frame;
+  frame.resize(30, 1);
+  frame.diff();
+
+  /* a short gap joins the changes, a long one or a new color splits them */
+  frame.put(0, 1, 'a');
+  frame.put(0, 1 + ConsoleFrame::kMaxGap + 1, 'b');
+  frame.put(0, 20, 'c');
+  frame.put(0, 21, 'd', 4);
+  const auto &runs = frame.diff();
+  ASSERT_EQ(runs.size(), 3u);
+  EXPECT_EQ(runs[0].x, 1);
+  EXPECT_EQ(runs[0].length, ConsoleFrame::kMaxGap + 2);
+  EXPECT_EQ(runs[1].x, 20);
+  EXPECT_EQ(runs[1].length, 1);
+  EXPECT_EQ(runs[2].color, 4);
+  EXPECT_EQ(frame.at(0, 21).glyph, U'd');
+}
+
+TEST(TestConsoleFrame, ForgetRedrawsEverything) {
+  ConsoleFrame frame;
+  frame.resize(4, 4);
+  frame.diff();
+  frame.forget();
+
+  int cells = 0;
+  for (const auto &run : frame.diff()) cells += run.length;
+  EXPECT_EQ(cells, 16);
+}
+
+TEST(TestAnsiBackend, EncodesChangedRuns) {
+  ConsoleFrame frame;
+  frame.resize(8, 2);
+  AnsiBackend backend;
+  backend.encode(frame);
+
+  frame.print(1, 2, "ab");
+  frame.put(1, 4, ConsoleGlyph::kHLine);
+  frame.put(1, 5, '.', 2);
+  const std::string bytes = backend.encode(frame);
+  EXPECT_EQ(bytes,
+            "\x1b[?2026h"
+            "\x1b[2;3H\x1b[0mab\xe2\x94\x80"
+            "\x1b[38;5;2;48;5;2m."
+            "\x1b[0m\x1b[?2026l");
+
+  EXPECT_TRUE(backend.encode(frame).empty());
+}
+
+TEST(TestAnsiBackend, DecodesKeys) {
+  size_t used = 0;
+  EXPECT_EQ(AnsiBackend::decodeKey("\x1b[A", 3, used), ConsoleKey::kUp);
+  EXPECT_EQ(used, 3u);
+  EXPECT_EQ(AnsiBackend::decodeKey("\x1bOD", 3, used), ConsoleKey::kLeft);
+  EXPECT_EQ(AnsiBackend::decodeKey("\x1b[1;5C", 6, used), ConsoleKey::kRight);
+  EXPECT_EQ(used, 6u);
+  EXPECT_EQ(AnsiBackend::decodeKey("\x1b", 1, used), 27);
+  EXPECT_EQ(used, 1u);
+  EXPECT_EQ(AnsiBackend::decodeKey(" \x1b[B", 4, used), ' ');
+  EXPECT_EQ(used, 1u);
+}
+
+TEST(TestAnsiBackend, DetectsSplitKeys) {
+  EXPECT_TRUE(AnsiBackend::isPartialKey("\x1b", 1));
+  EXPECT_TRUE(AnsiBackend::isPartialKey("\x1b[", 2));
+  EXPECT_TRUE(AnsiBackend::isPartialKey("\x1bO", 2));
+  EXPECT_TRUE(AnsiBackend::isPartialKey("\x1b[1;5", 5));
+  EXPECT_FALSE(AnsiBackend::isPartialKey("\x1b[A", 3));
+  EXPECT_FALSE(AnsiBackend::isPartialKey("\x1bx", 2));
+  EXPECT_FALSE(AnsiBackend::isPartialKey(" \x1b", 2));
+}
+
+TEST(TestAnsiBackend, ReadsKeysSplitAcrossReads) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  const int saved_stdin = dup(STDIN_FILENO);
+  dup2(fds[0], STDIN_FILENO);
+
+  /* the first read takes the 63 spaces and the ESC, the second the rest */
+  const std::string bytes = std::string(63, ' ') + "\x1b[A\x1b";
+  ASSERT_EQ(write(fds[1], bytes.data(), bytes.size()),
+            static_cast<ssize_t>(bytes.size()));
+  close(fds[1]);
+  AnsiBackend backend;
+  for (int i = 0; i < 63; ++i) ASSERT_EQ(backend.readKey(false), ' ');
+  EXPECT_EQ(backend.readKey(false), ConsoleKey::kUp);
+  EXPECT_EQ(backend.readKey(false), 27);
+  EXPECT_EQ(backend.readKey(false), ConsoleKey::kNone);
+
+  dup2(saved_stdin, STDIN_FILENO);
+  close(saved_stdin);
+  close(fds[0]);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "../src/brick_game/selfplay/SelfPlayPolicies.h"
+
+using namespace s21;
+
+TEST(TestWorkStealingPool, RunsEveryTaskOnce) {
+  WorkStealingPool pool(4);
+  std::vector<std::atomic<int>> runs(1000);
+  pool.run(runs.size(), [&runs](size_t task, size_t worker) {
+    EXPECT_LT(worker, 4u);
+    /* uneven work so that idle workers have something to steal */
+    if (task < 10) {
+      volatile size_t spin = 0;
+      for (size_t i = 0; i < 100000; ++i) spin = spin + i;
+    }
+    ++runs[task];
+  });
+  for (const auto &count : runs) EXPECT_EQ(count, 1);
+}
+
+TEST(TestSelfPlay, SameResultsOnAnyThreadCount) {
+  SelfPlayConfig config;
+  config.games = 24;
+  config.seed = 7;
+  config.max_steps = 3000;
+
+  config.threads = 1;
+  const SelfPlayStats single =
+      SelfPlayRunner<TetrisModel>(config, randomTetrisPolicy()).run();
+  config.threads = 4;
+  const SelfPlayStats parallel =
+      SelfPlayRunner<TetrisModel>(config, randomTetrisPolicy()).run();
+
+  ASSERT_EQ(single.games.size(), 24u);
+  EXPECT_EQ(single.games, parallel.games);
+  EXPECT_EQ(single.games[3].seed, 10u);
+}
+
+TEST(TestSelfPlay, AggregatesResults) {
+  SelfPlayConfig config;
+  config.games = 16;
+  config.threads = 2;
+  config.max_steps = 20000;
+  const SelfPlayStats stats =
+      SelfPlayRunner<SnakeModel>(config, greedySnakePolicy()).run();
+
+  size_t games_on_levels = 0;
+  for (size_t count : stats.levels) games_on_levels += count;
+  EXPECT_EQ(games_on_levels, 16u);
+  EXPECT_EQ(stats.finished, 16u);
+  EXPECT_LE(stats.min_score, stats.median_score);
+  EXPECT_LE(stats.median_score, stats.p90_score);
+  EXPECT_LE(stats.p90_score, stats.max_score);
+  EXPECT_GT(stats.max_score, 0u);
+  EXPECT_GT(stats.steps, 0u);
+  EXPECT_EQ(stats.mean_lines, 0);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "../src/brick_game/base/TripleBuffer.h"
+#include "../src/brick_game/tetris/TetrisModel.h"
+#include "../src/controller/Controller.h"
+
+using namespace s21;
+
+TEST(TestTripleBuffer, ReaderSeesLatestValue) {
+  TripleBuffer<int> buffer;
+  buffer.reset(1);
+  EXPECT_FALSE(buffer.update());
+  EXPECT_EQ(buffer.front(), 1);
+
+  buffer.back() = 2;
+  buffer.publish();
+  buffer.back() = 3;
+  buffer.publish();
+  EXPECT_TRUE(buffer.update());
+  EXPECT_EQ(buffer.front(), 3);
+  EXPECT_FALSE(buffer.update());
+  EXPECT_EQ(buffer.front(), 3);
+}
+
+TEST(TestTripleBuffer, ConcurrentValuesAreWhole) {
+  struct Pair {
+    long long a;
+    long long b;
+  };
+  TripleBuffer<Pair> buffer;
+  buffer.reset({0, 0});
+  std::thread writer([&buffer] {
+    for (long long i = 1; i <= 100000; ++i) {
+      buffer.back() = {i, -i};
+      buffer.publish();
+    }
+  });
+  long long last = 0;
+  while (last < 100000) {
+    buffer.update();
+    const Pair &pair = buffer.front();
+    ASSERT_EQ(pair.a, -pair.b);
+    ASSERT_GE(pair.a, last);
+    last = pair.a;
+  }
+  writer.join();
+}
+
+TEST(TestSimulationThread, TicksModelAndPublishes) {
+  TetrisModel model;
+  model.setScoreSaving(false);
+  Controller<TetrisModel, UserAction::NO_ACT> controller(&model);
+  controller.setModelToDefault();
+
+  controller.startSimulation();
+  EXPECT_TRUE(controller.isSimulating());
+  EXPECT_EQ(controller.getSnapshot().data.game_state, GameState::START);
+
+  controller.postAction(UserAction::SPACE_BTN);
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (controller.getSnapshot().data.game_state != GameState::MOVING &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(controller.getSnapshot().data.game_state, GameState::MOVING);
+
+  /* once the key is applied, the next snapshot shows it */
+  controller.postAction(UserAction::ESC_BTN);
+  while (!controller.isInputApplied() &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(controller.getSnapshot().data.game_state, GameState::EXIT);
+  controller.stopSimulation();
+  EXPECT_EQ(controller.getSnapshot().data.game_state, GameState::EXIT);
+  EXPECT_EQ(model.getModelData().game_state, GameState::EXIT);
+  EXPECT_EQ(controller.getSnapshot().version, model.getVersion());
+}
+
+TEST(TestInputQueue, KeepsOrderAndCapacity) {
+  InputQueue queue;
+  InputEvent event;
+  EXPECT_FALSE(queue.pop(event));
+  for (size_t i = 0; i < InputQueue::kCapacity; ++i) {
+    EXPECT_TRUE(queue.push({UserAction::LEFT_BTN, static_cast<long long>(i)}));
+  }
+  EXPECT_FALSE(queue.push({UserAction::RIGHT_BTN, 0}));
+  for (size_t i = 0; i < InputQueue::kCapacity; ++i) {
+    ASSERT_TRUE(queue.pop(event));
+    EXPECT_EQ(event.time, static_cast<long long>(i));
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(TestInputQueue, AppliesEveryActionOfATick) {
+  TetrisModel model;
+  model.setScoreSaving(false);
+  Controller<TetrisModel, UserAction::NO_ACT> controller(&model);
+  controller.setModelToDefault();
+  controller.postAction(UserAction::SPACE_BTN);
+  controller.applyInput();
+  controller.applyInput();
+  ASSERT_EQ(model.getModelData().game_state, GameState::MOVING);
+
+  /* a rotation and two shifts within one frame all land */
+  Figure expected = model.getModelData().cur_figure;
+  expected.Rotate();
+  expected.moveLeft();
+  expected.moveLeft();
+  controller.postAction(UserAction::UP_BTN);
+  controller.postAction(UserAction::LEFT_BTN);
+  controller.postAction(UserAction::LEFT_BTN);
+  controller.applyInput();
+  EXPECT_EQ(model.getModelData().cur_figure, expected);
+}
+
+TEST(TestInputQueue, DropsInputOfThePreviousGame) {
+  TetrisModel model;
+  model.setScoreSaving(false);
+  Controller<TetrisModel, UserAction::NO_ACT> controller(&model);
+  controller.setModelToDefault();
+  controller.postAction(UserAction::ESC_BTN);
+  controller.setModelToDefault();
+  controller.applyInput();
+  EXPECT_EQ(model.getModelData().game_state, GameState::START);
+
+  controller.postAction(UserAction::SPACE_BTN);
+  controller.stopSimulation();
+  controller.applyInput();
+  EXPECT_EQ(model.getModelData().game_state, GameState::START);
+}
+
+TEST(TestInputQueue, AppliesActionsInQueueOrder) {
+  TetrisModel model;
+  model.setScoreSaving(false);
+  VirtualClock clock;
+  model.setClock(&clock);
+  model.setDefault();
+  InputQueue queue;
+  /* ESC was queued first and must win over SPACE */
+  queue.push({UserAction::ESC_BTN, 0});
+  queue.push({UserAction::SPACE_BTN, 0});
+  model.applyInput(queue);
+  EXPECT_EQ(model.getModelData().game_state, GameState::EXIT);
+}
+
+TEST(TestInputQueue, AppliesEventsAtTheirTime) {
+  TetrisModel model;
+  model.setScoreSaving(false);
+  VirtualClock clock(1000);
+  model.setClock(&clock);
+  model.setDefault();
+  InputQueue queue;
+  queue.push({UserAction::SPACE_BTN, 1000});
+  model.applyInput(queue);
+  model.applyInput(queue);
+  ASSERT_EQ(model.getModelData().game_state, GameState::MOVING);
+  const int start_y = model.getModelData().cur_figure.getMinY();
+
+  /* the gravity step due at 1500 comes before the pause pressed at 1550 */
+  clock.set(1600);
+  queue.push({UserAction::TAB_BTN, 1550});
+  model.applyInput(queue);
+  EXPECT_EQ(model.getModelData().game_state, GameState::PAUSE);
+  EXPECT_EQ(model.getModelData().cur_figure.getMinY(), start_y + 1);
+
+  /* the pause kept the 50 ms the figure had already waited */
+  clock.set(2000);
+  queue.push({UserAction::TAB_BTN, 1900});
+  model.applyInput(queue);
+  EXPECT_EQ(model.getNextDeadline(), 2350);
+
+  /* the steps due after the last key are taken too, in the same tick */
+  clock.set(2400);
+  queue.push({UserAction::LEFT_BTN, 2100});
+  model.applyInput(queue);
+  EXPECT_EQ(model.getModelData().cur_figure.getMinY(), start_y + 2);
+  EXPECT_EQ(model.getNextDeadline(), 2850);
+
+  /* an event stamped in the future is applied at the time of the tick */
+  queue.push({UserAction::TAB_BTN, 99999});
+  model.applyInput(queue);
+  EXPECT_EQ(model.getModelData().game_state, GameState::PAUSE);
+  EXPECT_EQ(model.getCurTime(), 2400);
+  model.setClock(nullptr);
+}
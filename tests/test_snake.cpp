@@ -1,8 +1,6 @@
 
 #include <gtest/gtest.h>
 
-#include <thread>
-
 #include "../src/brick_game/snake/SnakeModel.h"
 
 using namespace s21;
@@ -23,8 +21,7 @@ TEST_F(TestSnake, MoveSnakeUp) {
   EXPECT_EQ(snake_game_data->game_state, GameState::MOVING);
   snake_model.updateData(UserAction::UP_BTN);
   EXPECT_EQ(snake_game_data->direction, Direction::UP);
-  std::this_thread::sleep_for(std::chrono::milliseconds(510));
-  snake_model.updateData(UserAction::NO_ACT);
+  snake_model.step({}, 51);
   snake_model.updateData(UserAction::ESC_BTN);
   EXPECT_EQ(snake_game_data->game_state, GameState::EXIT);
 }
@@ -38,8 +35,7 @@ TEST_F(TestSnake, MoveSnakeLeft) {
   snake_model.updateData(UserAction::NO_ACT);
   EXPECT_EQ(snake_game_data->game_state, GameState::MOVING);
   snake_model.updateData(UserAction::LEFT_BTN);
-  std::this_thread::sleep_for(std::chrono::milliseconds(510));
-  snake_model.updateData(UserAction::NO_ACT);
+  snake_model.step({}, 51);
   snake_model.updateData(UserAction::ESC_BTN);
   EXPECT_EQ(snake_game_data->game_state, GameState::EXIT);
 }
@@ -54,8 +50,7 @@ TEST_F(TestSnake, MoveSnakeRight) {
   EXPECT_EQ(snake_game_data->game_state, GameState::MOVING);
   snake_model.updateData(UserAction::RIGHT_BTN);
   EXPECT_EQ(snake_game_data->direction, Direction::RIGHT);
-  std::this_thread::sleep_for(std::chrono::milliseconds(510));
-  snake_model.updateData(UserAction::NO_ACT);
+  snake_model.step({}, 51);
   snake_model.updateData(UserAction::ESC_BTN);
   EXPECT_EQ(snake_game_data->game_state, GameState::EXIT);
 }
@@ -72,8 +67,7 @@ TEST_F(TestSnake, MoveSnakeAround) {
   EXPECT_EQ(snake_game_data->direction, Direction::RIGHT);
   snake_model.updateData(UserAction::DOWN_BTN);
   EXPECT_EQ(snake_game_data->direction, Direction::DOWN);
-  std::this_thread::sleep_for(std::chrono::milliseconds(510));
-  snake_model.updateData(UserAction::NO_ACT);
+  snake_model.step({}, 51);
   EXPECT_EQ(snake_game_data->direction, Direction::DOWN);
   snake_model.updateData(UserAction::LEFT_BTN);
   EXPECT_EQ(snake_game_data->direction, Direction::LEFT);
@@ -124,3 +118,133 @@ TEST_F(TestSnake, GameOverTest) {
   }
   EXPECT_EQ(snake_game_data->game_state, GameState::GAMEOVER);
 }
+
+TEST_F(TestSnake, ChangeLog) {
+  snake_model.setDefault();
+  snake_game_data = &snake_model.getModelData();
+  snake_model.updateData(UserAction::SPACE_BTN);
+  snake_model.updateData(UserAction::NO_ACT);
+  EXPECT_TRUE(snake_model.drainChanges().full_redraw);
+
+  const Cords tail = snake_game_data->snake_coord.back();
+  snake_game_data->fruit_coord = Cords(0, 0);
+  snake_model.updateData(UserAction::LEFT_BTN);
+  const ChangeLog &log = snake_model.drainChanges();
+  EXPECT_FALSE(log.full_redraw);
+  ASSERT_EQ(log.cells.size(), 2u);
+  EXPECT_EQ(log.cells[0].cell, tail);
+  EXPECT_EQ(log.cells[0].color, 0);
+  EXPECT_EQ(log.cells[1].cell, snake_game_data->snake_coord[0]);
+  EXPECT_EQ(log.cells[1].color, SnakeModel::kBodyColor);
+}
+
+TEST_F(TestSnake, GrowKeepsTail) {
+  snake_model.setDefault();
+  snake_game_data = &snake_model.getModelData();
+  snake_model.updateData(UserAction::SPACE_BTN);
+  snake_model.updateData(UserAction::NO_ACT);
+
+  const Cords head = snake_game_data->snake_coord.front();
+  const Cords tail = snake_game_data->snake_coord.back();
+  snake_game_data->fruit_coord = Cords(head.x_ - 1, head.y_);
+  snake_model.updateData(UserAction::LEFT_BTN);
+  ASSERT_EQ(snake_game_data->snake_coord.size(), 5u);
+  EXPECT_EQ(snake_game_data->snake_coord.front(), Cords(head.x_ - 1, head.y_));
+  EXPECT_EQ(snake_game_data->snake_coord[1], head);
+  EXPECT_EQ(snake_game_data->snake_coord.back(), tail);
+  EXPECT_EQ(snake_game_data->cur_score, 1);
+}
+
+TEST_F(TestSnake, OccupancyGrid) {
+  VirtualClock clock(0);
+  snake_model.setClock(&clock);
+  snake_model.setSeed(211);
+  snake_model.setDefault();
+  snake_game_data = &snake_model.getModelData();
+  const OccupancyGrid &grid = snake_model.getOccupancy();
+  EXPECT_EQ(grid.get(-1, 0), OccupancyGrid::Cell::WALL);
+  EXPECT_EQ(grid.get(ConstSizes::field_width, 0), OccupancyGrid::Cell::WALL);
+
+  size_t body = 0;
+  for (int y = 0; y < grid.height(); ++y) {
+    for (int x = 0; x < grid.width(); ++x) {
+      if (grid.get(x, y) == OccupancyGrid::Cell::BODY) ++body;
+    }
+  }
+  EXPECT_EQ(body, snake_game_data->snake_coord.size());
+  const Cords fruit = snake_game_data->fruit_coord;
+  EXPECT_EQ(grid.get(fruit.x_, fruit.y_), OccupancyGrid::Cell::FRUIT);
+
+  snake_model.updateData(UserAction::SPACE_BTN);
+  snake_model.updateData(UserAction::NO_ACT);
+  const Cords tail = snake_game_data->snake_coord.back();
+  /* turn away from the fruit, so that the snake does not grow */
+  const Cords start = snake_game_data->snake_coord.front();
+  const bool fruit_left =
+      snake_game_data->fruit_coord == Cords(start.x_ - 1, start.y_);
+  snake_model.updateData(fruit_left ? UserAction::RIGHT_BTN
+                                    : UserAction::LEFT_BTN);
+  const Cords head = snake_game_data->snake_coord.front();
+  EXPECT_EQ(grid.get(head.x_, head.y_), OccupancyGrid::Cell::BODY);
+  EXPECT_EQ(grid.get(tail.x_, tail.y_), OccupancyGrid::Cell::EMPTY);
+  snake_model.setClock(nullptr);
+}
+
+TEST(TestOccupancyGrid, FreeCells) {
+  OccupancyGrid grid;
+  grid.reset(3, 2);
+  EXPECT_EQ(grid.freeCount(), 6);
+
+  Random rng(7);
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 3; ++x) grid.set(x, y, OccupancyGrid::Cell::BODY);
+  }
+  EXPECT_EQ(grid.freeCount(), 0);
+
+  grid.set(1, 1, OccupancyGrid::Cell::EMPTY);
+  ASSERT_EQ(grid.freeCount(), 1);
+  EXPECT_EQ(grid.randomFree(rng), Cords(1, 1));
+
+  grid.set(2, 0, OccupancyGrid::Cell::EMPTY);
+  grid.set(1, 1, OccupancyGrid::Cell::FRUIT);
+  ASSERT_EQ(grid.freeCount(), 1);
+  EXPECT_EQ(grid.randomFree(rng), Cords(2, 0));
+}
+
+TEST(TestSnakeSize, CustomFieldSize) {
+  SnakeModel model(1024, 1024);
+  model.setDefault();
+  SnakeModel::GameData *data = &model.getModelData();
+  EXPECT_EQ(model.getOccupancy().freeCount(), 1024 * 1024 - 5);
+  EXPECT_EQ(data->snake_coord.front(), Cords(512, 512));
+
+  model.updateData(UserAction::SPACE_BTN);
+  model.updateData(UserAction::NO_ACT);
+  model.step({}, 500);
+  EXPECT_EQ(data->game_state, GameState::MOVING);
+  EXPECT_GE(data->snake_coord.capacity(), 1024u * 1024u);
+}
+
+TEST_F(TestSnake, MovesCatchUpWithoutPause) {
+  VirtualClock clock(0);
+  snake_model.setClock(&clock);
+  snake_model.setDefault();
+  snake_game_data = &snake_model.getModelData();
+  snake_model.updateData(UserAction::SPACE_BTN);
+  snake_model.updateData(UserAction::NO_ACT);
+  const Cords start = snake_game_data->snake_coord.front();
+  const Cords moved(start.x_, start.y_ - 2);
+
+  clock.advance(1000);
+  snake_model.updateData(UserAction::NO_ACT);
+  EXPECT_EQ(snake_game_data->snake_coord.front(), moved);
+
+  /* the time on pause is not made up after it */
+  clock.advance(200);
+  snake_model.updateData(UserAction::TAB_BTN);
+  clock.advance(5000);
+  snake_model.updateData(UserAction::TAB_BTN);
+  EXPECT_EQ(snake_model.getTimeToDeadline(), 300);
+  EXPECT_EQ(snake_game_data->snake_coord.front(), moved);
+  snake_model.setClock(nullptr);
+}
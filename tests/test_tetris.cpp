@@ -1,7 +1,7 @@
 
 #include <gtest/gtest.h>
 
-#include <thread>
+#include <memory>
 
 #include "../src/brick_game/tetris/TetrisModel.h"
 
@@ -28,8 +28,7 @@ TEST_F(TetrisGameTest, MoveFigure) {
   tetris_model.updateData(UserAction::RIGHT_BTN);
   EXPECT_TRUE(expected_cords == game_data->cur_figure.getCords());
 
-  std::this_thread::sleep_for(std::chrono::milliseconds(510));
-  tetris_model.updateData(UserAction::NO_ACT);
+  tetris_model.step({}, 51);
 
   for (size_t i = 0; i < expected_cords.size(); ++i) {
     EXPECT_EQ(expected_cords[i].y_ + 1, game_data->cur_figure.getCords()[i].y_);
@@ -123,12 +122,13 @@ TEST_F(TetrisGameTest, ScoreTest) {
   /* 1 line */
   for (int i = 19; i < 20; ++i) {
     for (int j = 0; j < 10; ++j) {
-      game_data->game_field[i][j].first = true;
+      game_data->game_field.setCell(i, j, 1);
     }
   }
 
   tetris_model.updateData(UserAction::SPACE_BTN);
   EXPECT_EQ(game_data->cur_score, 100);
+  EXPECT_EQ(game_data->lines, 1u);
 
   tetris_model.setDefault();
   tetris_model.updateData(UserAction::SPACE_BTN);
@@ -137,13 +137,370 @@ TEST_F(TetrisGameTest, ScoreTest) {
   /* 4 lines */
   for (int i = 16; i < 20; ++i) {
     for (int j = 0; j < 10; ++j) {
-      game_data->game_field[i][j].first = true;
+      game_data->game_field.setCell(i, j, 1);
     }
   }
 
   tetris_model.updateData(UserAction::SPACE_BTN);
   EXPECT_EQ(game_data->cur_score, 1500);
+  EXPECT_EQ(game_data->lines, 4u);
 
   tetris_model.updateData(UserAction::ESC_BTN);
   EXPECT_EQ(game_data->game_state, GameState::EXIT);
 }
+
+TEST(TetrisBoardTest, RowMasks) {
+  Board board;
+  for (int j = 0; j < board.width(); ++j) board.setCell(19, j, 2);
+  board.setCell(18, 3, 5);
+  EXPECT_TRUE(board.isRowFull(19));
+  EXPECT_FALSE(board.isRowFull(18));
+  EXPECT_EQ(board.getRow(18), 1u << 3);
+  EXPECT_EQ(board.getColor(18, 3), 5);
+
+  EXPECT_EQ(board.clearFullRows(), Board::ClearedRows{19});
+  EXPECT_TRUE(board.isFilled(19, 3));
+  EXPECT_EQ(board.getColor(19, 3), 5);
+  EXPECT_TRUE(board.isRowEmpty(18));
+
+  board.resetCell(19, 3);
+  EXPECT_FALSE(board.isFilled(19, 3));
+  EXPECT_EQ(board.getColor(19, 3), 0);
+}
+
+TEST(TetrisFigureTest, RotationTable) {
+  Figure figure;
+  figure.setShape(Shape::T);
+  auto start = figure.getCords();
+  for (int i = 0; i < FigureCords::kRotations; ++i) {
+    figure.Rotate();
+    EXPECT_GE(figure.getMinX(), 0);
+    EXPECT_LT(figure.getMaxX(), ConstSizes::field_width);
+    EXPECT_GE(figure.getMinY(), 1);
+  }
+  EXPECT_EQ(figure.getRotation(), 0);
+  const auto &cords = figure.getCords();
+  for (size_t i = 0; i < cords.size(); ++i) {
+    EXPECT_EQ(cords[i].x_ - start[i].x_, cords[0].x_ - start[0].x_);
+    EXPECT_EQ(cords[i].y_ - start[i].y_, cords[0].y_ - start[0].y_);
+  }
+
+  figure.setShape(Shape::I);
+  figure.setRotation(1);
+  while (figure.getMinX() > 0) figure.moveLeft();
+  EXPECT_EQ(figure.getMaxX() - figure.getMinX(), 3);
+  figure.setRotation(2);
+  EXPECT_EQ(figure.getMinX(), figure.getMaxX());
+}
+
+TEST_F(TetrisGameTest, ColumnHeights) {
+  tetris_model.setDefault();
+  game_data = &tetris_model.getModelData();
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  tetris_model.updateData(UserAction::NO_ACT);
+
+  const Board &field = game_data->game_field;
+  for (int j = 0; j < field.width(); ++j) {
+    EXPECT_EQ(tetris_model.getColumnHeights()[j], 0);
+  }
+
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  int filled = 0;
+  for (int j = 0; j < field.width(); ++j) {
+    int expected = 0;
+    for (int i = 0; i < field.height() && !expected; ++i) {
+      if (field.isFilled(i, j)) expected = field.height() - i;
+    }
+    EXPECT_EQ(tetris_model.getColumnHeights()[j], expected);
+    filled += expected > 0;
+  }
+  EXPECT_GT(filled, 0);
+
+  Figure ghost = game_data->cur_figure;
+  while (ghost.getMaxY() < field.height()) {
+    bool blocked = false;
+    for (const auto &c : ghost.getCords()) {
+      if (game_data->game_field.isFilled(c.y_, c.x_)) blocked = true;
+    }
+    if (blocked) break;
+    ghost.moveDown();
+  }
+  EXPECT_TRUE(ghost == game_data->projection);
+}
+
+TEST(TetrisBoardTest, ClearRowOverGap) {
+  Board board;
+  const int bottom = board.height() - 1;
+  for (int j = 0; j < board.width(); ++j) board.setCell(bottom - 2, j, 1);
+  board.setCell(bottom, 0, 2);
+
+  /* column 0 drops to the cell under its gap, the others empty out */
+  EXPECT_EQ(board.clearFullRows(), (Board::ClearedRows{bottom - 2}));
+  EXPECT_EQ(board.getHeights()[0], 1);
+  for (int j = 1; j < board.width(); ++j) {
+    EXPECT_EQ(board.getHeights()[j], 0);
+  }
+}
+
+TEST(TetrisBoardTest, ClearSeveralRows) {
+  Board board;
+  for (int i : {13, 15, 16, 19}) {
+    for (int j = 0; j < board.width(); ++j) board.setCell(i, j, 1);
+  }
+  board.setCell(14, 0, 3);
+  board.setCell(17, 9, 4);
+  board.setCell(18, 5, 6);
+
+  EXPECT_EQ(board.clearFullRows(), (Board::ClearedRows{19, 16, 15, 13}));
+  EXPECT_EQ(board.getRow(19), 1u << 5);
+  EXPECT_EQ(board.getRow(18), 1u << 9);
+  EXPECT_EQ(board.getRow(17), 1u << 0);
+  EXPECT_EQ(board.getColor(17, 0), 3);
+  for (int i = 0; i < 17; ++i) EXPECT_TRUE(board.isRowEmpty(i));
+  EXPECT_EQ(board.getHeights()[0], 3);
+  EXPECT_EQ(board.getHeights()[5], 1);
+  EXPECT_EQ(board.getHeights()[9], 2);
+  EXPECT_EQ(board.getHeights()[1], 0);
+  EXPECT_TRUE(board.clearFullRows().empty());
+}
+
+TEST_F(TetrisGameTest, VersionCounters) {
+  tetris_model.setDefault();
+  game_data = &tetris_model.getModelData();
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  tetris_model.updateData(UserAction::NO_ACT);
+
+  auto version = tetris_model.getVersion();
+  EXPECT_EQ(tetris_model.changedSince(version), 0u);
+
+  while (game_data->cur_figure.getMinX() > 0) {
+    tetris_model.updateData(UserAction::LEFT_BTN);
+  }
+  EXPECT_EQ(tetris_model.changedSince(version),
+            BaseModel::componentBit(ModelComponent::FIGURE));
+
+  version = tetris_model.getVersion();
+  tetris_model.updateData(UserAction::LEFT_BTN);
+  EXPECT_FALSE(game_data->was_modified);
+  EXPECT_EQ(tetris_model.changedSince(version), 0u);
+
+  tetris_model.updateData(UserAction::TAB_BTN);
+  EXPECT_TRUE(game_data->was_modified);
+  EXPECT_EQ(tetris_model.changedSince(version),
+            BaseModel::componentBit(ModelComponent::STATE));
+
+  version = tetris_model.getVersion();
+  tetris_model.updateData(UserAction::TAB_BTN);
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  unsigned changes = tetris_model.changedSince(version);
+  EXPECT_TRUE(changes & BaseModel::componentBit(ModelComponent::FIELD));
+  EXPECT_TRUE(changes & BaseModel::componentBit(ModelComponent::FIGURE));
+  EXPECT_GT(tetris_model.getVersion(ModelComponent::FIELD), version);
+}
+
+TEST_F(TetrisGameTest, ChangeLog) {
+  tetris_model.setDefault();
+  game_data = &tetris_model.getModelData();
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  tetris_model.updateData(UserAction::NO_ACT);
+  EXPECT_TRUE(tetris_model.drainChanges().full_redraw);
+  EXPECT_TRUE(tetris_model.drainChanges().cells.empty());
+
+  const Figure before = game_data->cur_figure;
+  tetris_model.updateData(UserAction::RIGHT_BTN);
+  const ChangeLog &log = tetris_model.drainChanges();
+  EXPECT_FALSE(log.full_redraw);
+  EXPECT_EQ(log.hud, 0u);
+  EXPECT_FALSE(log.cells.empty());
+  for (const auto &c : game_data->cur_figure.getCords()) {
+    bool found = false;
+    for (const auto &change : log.cells) {
+      if (change.cell == Cords(c.x_, c.y_ - 1)) {
+        found = true;
+        EXPECT_EQ(change.color, static_cast<int>(before.getShape()));
+      }
+    }
+    EXPECT_TRUE(found);
+  }
+  for (const auto &change : log.cells) {
+    EXPECT_EQ(change.color,
+              tetris_model.getCellColor(change.cell.x_, change.cell.y_));
+  }
+
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  EXPECT_TRUE(tetris_model.drainChanges().hud &
+              BaseModel::hudBit(HudItem::NEXT_FIGURE));
+}
+
+TEST_F(TetrisGameTest, VirtualClock) {
+  VirtualClock clock(1000);
+  tetris_model.setClock(&clock);
+  tetris_model.setDefault();
+  game_data = &tetris_model.getModelData();
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  tetris_model.updateData(UserAction::NO_ACT);
+
+  const int start_y = game_data->cur_figure.getMinY();
+  clock.advance(499);
+  tetris_model.updateData(UserAction::NO_ACT);
+  EXPECT_EQ(game_data->cur_figure.getMinY(), start_y);
+  clock.advance(1);
+  tetris_model.updateData(UserAction::NO_ACT);
+  EXPECT_EQ(game_data->cur_figure.getMinY(), start_y + 1);
+
+  tetris_model.step({UserAction::LEFT_BTN}, 50);
+  EXPECT_EQ(game_data->cur_figure.getMinY(), start_y + 2);
+
+  /* the model is back on the clock, with the gravity step moved onto it */
+  EXPECT_EQ(tetris_model.getCurTime(), clock.now());
+  EXPECT_EQ(tetris_model.getNextDeadline(), clock.now() + 500);
+  clock.advance(499);
+  tetris_model.updateData(UserAction::NO_ACT);
+  EXPECT_EQ(game_data->cur_figure.getMinY(), start_y + 2);
+  clock.advance(1);
+  tetris_model.updateData(UserAction::NO_ACT);
+  EXPECT_EQ(game_data->cur_figure.getMinY(), start_y + 3);
+  tetris_model.setClock(nullptr);
+}
+
+TEST_F(TetrisGameTest, CopyKeepsOwnClock) {
+  VirtualClock clock(1000);
+  tetris_model.setClock(&clock);
+  tetris_model.setDefault();
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  tetris_model.updateData(UserAction::NO_ACT);
+
+  auto copy = std::make_unique<TetrisModel>(tetris_model);
+  tetris_model.step({}, 50);
+  EXPECT_EQ(copy->getCurTime(), clock.now());
+
+  TetrisModel assigned;
+  assigned = *copy;
+  copy.reset();
+  EXPECT_EQ(assigned.getCurTime(), clock.now());
+  tetris_model.setClock(nullptr);
+}
+
+TEST(ModelClockTest, CopyRunsOnOwnVirtualClock) {
+  ModelClock clock;
+  clock.getVirtual().set(5);
+  clock.setSource(&clock.getVirtual());
+
+  ModelClock copy(clock);
+  ModelClock assigned;
+  assigned = clock;
+  clock.getVirtual().set(9);
+  EXPECT_EQ(copy.getSource(), &copy.getVirtual());
+  EXPECT_EQ(copy.now(), 5);
+  EXPECT_EQ(assigned.getSource(), &assigned.getVirtual());
+  EXPECT_EQ(assigned.now(), 5);
+}
+
+TEST_F(TetrisGameTest, NextDeadline) {
+  VirtualClock clock(1000);
+  tetris_model.setClock(&clock);
+  tetris_model.setDefault();
+  EXPECT_EQ(tetris_model.getNextDeadline(), BaseModel::kNoDeadline);
+
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  EXPECT_EQ(tetris_model.getTimeToDeadline(), 0);
+  tetris_model.updateData(UserAction::NO_ACT);
+  EXPECT_EQ(tetris_model.getNextDeadline(), 1500);
+  clock.advance(120);
+  EXPECT_EQ(tetris_model.getTimeToDeadline(), 380);
+
+  tetris_model.updateData(UserAction::TAB_BTN);
+  EXPECT_EQ(tetris_model.getTimeToDeadline(), BaseModel::kNoDeadline);
+  tetris_model.setClock(nullptr);
+}
+
+TEST_F(TetrisGameTest, GravityCatchesUp) {
+  VirtualClock clock(0);
+  tetris_model.setClock(&clock);
+  tetris_model.setDefault();
+  tetris_model.updateData(UserAction::SPACE_BTN);
+  tetris_model.updateData(UserAction::NO_ACT);
+  const int start_y = game_data->cur_figure.getCords()[0].y_;
+
+  /* a late update applies every elapsed step and keeps the remainder */
+  clock.advance(1499);
+  tetris_model.updateData(UserAction::NO_ACT);
+  EXPECT_EQ(game_data->cur_figure.getCords()[0].y_, start_y + 2);
+  EXPECT_EQ(tetris_model.getTimeToDeadline(), 1);
+  clock.advance(1);
+  tetris_model.updateData(UserAction::NO_ACT);
+  EXPECT_EQ(game_data->cur_figure.getCords()[0].y_, start_y + 3);
+  tetris_model.setClock(nullptr);
+}
+
+TEST(TetrisPieceBagTest, EveryShapeOncePerBag) {
+  Random rng(42);
+  PieceBag bag;
+  bag.reset(rng);
+  for (int block = 0; block < 10; ++block) {
+    int seen[8] = {};
+    for (size_t i = 0; i < PieceBag::kBagSize; ++i) {
+      Shape peeked = bag.peek(0);
+      Shape shape = bag.next(rng);
+      EXPECT_EQ(peeked, shape);
+      seen[static_cast<int>(shape)]++;
+    }
+    for (int s = 1; s <= 7; ++s) EXPECT_EQ(seen[s], 1);
+  }
+}
+
+TEST(TetrisSeedTest, SameSeedSameGame) {
+  TetrisModel first;
+  TetrisModel second;
+  const std::vector<UserAction> actions = {
+      UserAction::SPACE_BTN, UserAction::NO_ACT,   UserAction::LEFT_BTN,
+      UserAction::UP_BTN,    UserAction::SPACE_BTN, UserAction::RIGHT_BTN,
+      UserAction::RIGHT_BTN, UserAction::SPACE_BTN, UserAction::UP_BTN,
+      UserAction::SPACE_BTN};
+  for (auto *model : {&first, &second}) {
+    VirtualClock clock(0);
+    model->setClock(&clock);
+    model->setSeed(1234);
+    model->setDefault();
+    model->step(actions, 2000);
+    model->setClock(nullptr);
+  }
+  EXPECT_TRUE(first.getModelData() == second.getModelData());
+  EXPECT_EQ(first.getModelData().cur_score, second.getModelData().cur_score);
+}
+
+TEST(TetrisBoardTest, WideBoard) {
+  Board board(130, 1024);
+  EXPECT_EQ(board.width(), 130);
+  for (int j = 0; j < board.width(); ++j) board.setCell(1023, j, 1);
+  board.setCell(1022, 129, 4);
+  EXPECT_TRUE(board.isRowFull(1023));
+  EXPECT_FALSE(board.isRowFull(1022));
+  EXPECT_EQ(board.getRow(1022, 2), 1u << 1);
+
+  EXPECT_EQ(board.clearFullRows(), Board::ClearedRows{1023});
+  EXPECT_TRUE(board.isFilled(1023, 129));
+  EXPECT_EQ(board.getColor(1023, 129), 4);
+  EXPECT_EQ(board.getHeights()[129], 1);
+  EXPECT_EQ(board.getHeights()[0], 0);
+}
+
+TEST(TetrisSizeTest, CustomFieldSize) {
+  TetrisModel model(64, 100);
+  EXPECT_EQ(model.getFieldWidth(), 64);
+  EXPECT_EQ(model.getFieldHeight(), 100);
+  TetrisModel::GameData *data = &model.getModelData();
+  EXPECT_EQ(data->game_field.width(), 64);
+  EXPECT_GE(data->cur_figure.getMinX(), 28);
+
+  model.updateData(UserAction::SPACE_BTN);
+  model.updateData(UserAction::NO_ACT);
+  model.updateData(UserAction::SPACE_BTN);
+  EXPECT_GT(*std::max_element(model.getColumnHeights().begin(),
+                              model.getColumnHeights().end()),
+            0);
+
+  TetrisModel clamped(1, 100000);
+  EXPECT_EQ(clamped.getFieldWidth(), ConstSizes::min_field_size);
+  EXPECT_EQ(clamped.getFieldHeight(), ConstSizes::max_field_size);
+}